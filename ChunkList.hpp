@@ -4,10 +4,465 @@
 #include <memory>
 #include <list>
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <compare>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CHUNK_LIST_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define CHUNK_LIST_X86_SIMD 0
+#endif
 
 namespace fefu_laboratory_two {
 
-    template<typename T>
+    /// @brief Память, полученная пулом от системы, в байтах.
+    struct pool_usage {
+        std::size_t arena_bytes = 0;   // арены, из которых нарезаются блоки; пулом не возвращаются
+        std::size_t block_bytes = 0;   // блоки арен, выданные из пула (включая магазины потоков)
+        std::size_t direct_bytes = 0;  // крупные блоки, выделенные напрямую через operator new
+    };
+
+    namespace detail {
+
+        // Пул блоков фиксированных размеров. Запросы до max_block байт округляются вверх до
+        // класса, кратного block_granularity, и обслуживаются из крупных арен. Освобождённые
+        // блоки образуют интрузивный список: указатель на следующий блок хранится в самом блоке.
+        // Остальные запросы уходят в operator new.
+        class chunk_pool {
+        public:
+            static constexpr std::size_t block_granularity = 64;
+            static constexpr std::size_t max_block = 64 * 1024;
+            static constexpr std::size_t arena_size = 256 * 1024;
+
+            static chunk_pool &instance() {
+                // Пул намеренно не разрушается: контейнеры со статическим временем жизни
+                // возвращают в него память уже после выхода из main
+                static chunk_pool *pool = new chunk_pool;
+                return *pool;
+            }
+
+            static bool pooled(std::size_t bytes, std::size_t alignment) noexcept {
+                return bytes <= max_block && alignment <= block_granularity;
+            }
+
+            void *allocate(std::size_t bytes, std::size_t alignment) {
+                if (!pooled(bytes, alignment)) {
+                    void *p = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+                              ? ::operator new(bytes, std::align_val_t(alignment))
+                              : ::operator new(bytes);
+                    direct_total.fetch_add(bytes, std::memory_order_relaxed);
+                    return p;
+                }
+                size_class &cls = classes[class_of(bytes)];
+                std::lock_guard<std::mutex> lock(cls.mutex);
+                return take(cls, bytes);
+            }
+
+            // Выдаёт до count блоков одного класса под одной блокировкой. Возвращает число
+            // выданных блоков (не меньше одного).
+            std::size_t allocate_batch(std::size_t bytes, void **blocks, std::size_t count) {
+                size_class &cls = classes[class_of(bytes)];
+                std::lock_guard<std::mutex> lock(cls.mutex);
+                std::size_t taken = 0;
+                do {
+                    blocks[taken++] = take(cls, bytes);
+                } while (taken < count && (cls.free_list != nullptr || cls.cursor != cls.limit));
+                return taken;
+            }
+
+            void deallocate(void *p, std::size_t bytes, std::size_t alignment) noexcept {
+                if (!pooled(bytes, alignment)) {
+                    direct_total.fetch_sub(bytes, std::memory_order_relaxed);
+                    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                        ::operator delete(p, bytes, std::align_val_t(alignment));
+                    } else {
+                        ::operator delete(p, bytes);
+                    }
+                    return;
+                }
+                size_class &cls = classes[class_of(bytes)];
+                std::lock_guard<std::mutex> lock(cls.mutex);
+                cls.free_list = ::new(p) free_block{cls.free_list};
+                block_total.fetch_sub(block_size(bytes), std::memory_order_relaxed);
+            }
+
+            // Возвращает count блоков одного класса под одной блокировкой
+            void deallocate_batch(std::size_t bytes, void *const *blocks, std::size_t count) noexcept {
+                size_class &cls = classes[class_of(bytes)];
+                std::lock_guard<std::mutex> lock(cls.mutex);
+                for (std::size_t i = 0; i < count; ++i) {
+                    cls.free_list = ::new(blocks[i]) free_block{cls.free_list};
+                }
+                block_total.fetch_sub(block_size(bytes) * count, std::memory_order_relaxed);
+            }
+
+            // Текущие объёмы памяти пула. Счётчики читаются без блокировок, поэтому при
+            // одновременных выделениях в других потоках значения согласованы лишь приблизительно.
+            pool_usage usage() const noexcept {
+                return {arena_total.load(std::memory_order_relaxed), block_total.load(std::memory_order_relaxed),
+                        direct_total.load(std::memory_order_relaxed)};
+            }
+
+            static constexpr std::size_t class_count = max_block / block_granularity;
+
+            static std::size_t class_of(std::size_t bytes) noexcept {
+                return (std::max<std::size_t>(bytes, 1) - 1) / block_granularity;
+            }
+
+            // Размер блока, которым обслуживается запрос на bytes байт
+            static std::size_t block_size(std::size_t bytes) noexcept {
+                return (class_of(bytes) + 1) * block_granularity;
+            }
+
+        private:
+            struct free_block {
+                free_block *next;
+            };
+
+            // Свободные блоки одного размера и ещё не нарезанный остаток текущей арены
+            struct size_class {
+                std::mutex mutex;
+                free_block *free_list = nullptr;
+                unsigned char *cursor = nullptr;
+                unsigned char *limit = nullptr;
+            };
+
+            size_class classes[class_count];
+            std::atomic<std::size_t> arena_total{0};
+            std::atomic<std::size_t> block_total{0};
+            std::atomic<std::size_t> direct_total{0};
+
+            chunk_pool() = default;
+
+            // Берёт блок из списка свободных или отрезает от арены; вызывается под блокировкой класса
+            void *take(size_class &cls, std::size_t bytes) {
+                std::size_t size = block_size(bytes);
+                block_total.fetch_add(size, std::memory_order_relaxed);
+                if (cls.free_list != nullptr) {
+                    free_block *block = cls.free_list;
+                    cls.free_list = block->next;
+                    return block;
+                }
+                if (cls.cursor == cls.limit) {
+                    std::size_t bytes_in_arena = std::max(arena_size, 4 * size);
+                    try {
+                        cls.cursor = static_cast<unsigned char *>(
+                                ::operator new(bytes_in_arena, std::align_val_t(block_granularity)));
+                    } catch (...) {
+                        block_total.fetch_sub(size, std::memory_order_relaxed);
+                        throw;
+                    }
+                    cls.limit = cls.cursor + bytes_in_arena / size * size;
+                    arena_total.fetch_add(bytes_in_arena, std::memory_order_relaxed);
+                }
+                void *block = cls.cursor;
+                cls.cursor += size;
+                return block;
+            }
+        };
+    }
+
+    namespace detail {
+
+        // Пул потоков с перехватом работы для параллельных алгоритмов. Задание - диапазон
+        // номеров [first, last); поток, взявший задание, отдаёт его вторую половину в свою
+        // очередь и продолжает с первой, пока не останется один номер. Свободные потоки
+        // забирают задания с противоположного конца чужих очередей, так что крупные куски
+        // работы переезжают целиком. Вызывающий поток участвует в работе, поэтому вложенные
+        // вызовы run не блокируют пул.
+        class task_pool {
+        public:
+            static task_pool &instance() {
+                // Пул намеренно не разрушается, как и chunk_pool: рабочие потоки живут до
+                // завершения процесса
+                static task_pool *pool = new task_pool;
+                return *pool;
+            }
+
+            // Число потоков, выполняющих работу, включая вызывающий
+            std::size_t concurrency() const noexcept {
+                return workers + 1;
+            }
+
+            // Вызывает job(first, last) для непересекающихся диапазонов, покрывающих [0, count),
+            // и возвращается, когда все они выполнены. Первое исключение из job пробрасывается
+            // вызывающему после завершения остальных диапазонов.
+            template<class Job>
+            void run(std::size_t count, Job &job) {
+                if (count == 0) {
+                    return;
+                }
+                if (count == 1 || workers == 0) {
+                    job(0, count);
+                    return;
+                }
+                batch work{&job, &invoke<Job>, count};
+                push(workers, task{&work, 0, count});
+                std::size_t self = workers;
+                while (work.remaining.load(std::memory_order_acquire) != 0) {
+                    task next;
+                    if (!pop(self, next) && !steal(self, next)) {
+                        break;
+                    }
+                    execute(self, next);
+                }
+                // Ждём флаг под блокировкой: поток, завершивший последний диапазон, ещё держит
+                // ссылку на work, пока не отпустит мьютекс
+                {
+                    std::unique_lock<std::mutex> lock(work.mutex);
+                    work.done.wait(lock, [&] { return work.finished; });
+                }
+                if (work.error) {
+                    std::rethrow_exception(work.error);
+                }
+            }
+
+        private:
+            struct batch {
+                void *job;
+                void (*call)(void *, std::size_t, std::size_t);
+                std::atomic<std::size_t> remaining;
+                std::mutex mutex;
+                std::condition_variable done;
+                std::exception_ptr error;
+                bool finished = false;
+
+                batch(void *job, void (*call)(void *, std::size_t, std::size_t), std::size_t count)
+                        : job(job), call(call), remaining(count) {
+                }
+            };
+
+            struct task {
+                batch *owner = nullptr;
+                std::size_t first = 0;
+                std::size_t last = 0;
+            };
+
+            // Очередь потока: владелец берёт задания с конца, остальные - с начала.
+            // Последняя очередь общая для потоков, вызывающих run.
+            struct task_queue {
+                std::mutex mutex;
+                std::deque<task> tasks;
+            };
+
+            std::size_t workers;
+            std::unique_ptr<task_queue[]> queues;
+            std::atomic<std::size_t> queued{0};
+            std::mutex sleep_mutex;
+            std::condition_variable wake;
+
+            task_pool() : workers(std::max(std::thread::hardware_concurrency(), 1u) - 1),
+                          queues(new task_queue[workers + 1]) {
+                for (std::size_t i = 0; i < workers; ++i) {
+                    std::thread([this, i] { work(i); }).detach();
+                }
+            }
+
+            template<class Job>
+            static void invoke(void *job, std::size_t first, std::size_t last) {
+                (*static_cast<Job *>(job))(first, last);
+            }
+
+            void work(std::size_t self) {
+                while (true) {
+                    task next;
+                    if (pop(self, next) || steal(self, next)) {
+                        execute(self, next);
+                        continue;
+                    }
+                    std::unique_lock<std::mutex> lock(sleep_mutex);
+                    wake.wait(lock, [this] { return queued.load() != 0; });
+                }
+            }
+
+            void push(std::size_t self, const task &t) {
+                {
+                    // Счётчик растёт под тем же замком, под которым pop и steal его уменьшают:
+                    // иначе вычитание может опередить прибавление, и queued переполнится вниз.
+                    // Прибавление идёт после push_back, чтобы исключение не оставило лишний счёт.
+                    std::lock_guard<std::mutex> lock(queues[self].mutex);
+                    queues[self].tasks.push_back(t);
+                    queued.fetch_add(1);
+                }
+                // Захват sleep_mutex упорядочивает уведомление с проверкой условия в work
+                std::lock_guard<std::mutex> lock(sleep_mutex);
+                wake.notify_one();
+            }
+
+            bool pop(std::size_t self, task &t) {
+                std::lock_guard<std::mutex> lock(queues[self].mutex);
+                if (queues[self].tasks.empty()) {
+                    return false;
+                }
+                t = queues[self].tasks.back();
+                queues[self].tasks.pop_back();
+                queued.fetch_sub(1);
+                return true;
+            }
+
+            bool steal(std::size_t self, task &t) {
+                for (std::size_t i = 1; i <= workers; ++i) {
+                    task_queue &victim = queues[(self + i) % (workers + 1)];
+                    std::lock_guard<std::mutex> lock(victim.mutex);
+                    if (!victim.tasks.empty()) {
+                        t = victim.tasks.front();
+                        victim.tasks.pop_front();
+                        queued.fetch_sub(1);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void execute(std::size_t self, task t) {
+                while (t.last - t.first > 1) {
+                    std::size_t middle = t.first + (t.last - t.first) / 2;
+                    push(self, task{t.owner, middle, t.last});
+                    t.last = middle;
+                }
+                batch &work = *t.owner;
+                try {
+                    work.call(work.job, t.first, t.last);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(work.mutex);
+                    if (!work.error) {
+                        work.error = std::current_exception();
+                    }
+                }
+                if (work.remaining.fetch_sub(t.last - t.first, std::memory_order_acq_rel) == t.last - t.first) {
+                    std::lock_guard<std::mutex> lock(work.mutex);
+                    work.finished = true;
+                    work.done.notify_all();
+                }
+            }
+        };
+    }
+
+    /// @brief Источник памяти аллокатора по умолчанию: общий пул chunk_pool, блокировка
+    /// берётся отдельно для каждого класса размеров.
+    struct shared_pool {
+        static void *allocate(std::size_t bytes, std::size_t alignment) {
+            return detail::chunk_pool::instance().allocate(bytes, alignment);
+        }
+
+        static void deallocate(void *p, std::size_t bytes, std::size_t alignment) noexcept {
+            detail::chunk_pool::instance().deallocate(p, bytes, alignment);
+        }
+
+        static pool_usage usage() noexcept {
+            return detail::chunk_pool::instance().usage();
+        }
+    };
+
+    /// @brief Источник памяти с кэшем на каждый поток. Поток держит для каждого класса размеров
+    /// небольшой магазин свободных блоков и обращается к общему пулу только когда магазин пуст
+    /// или полон, забирая или возвращая сразу половину магазина под одной блокировкой.
+    /// Блоки можно освобождать в любом потоке. При завершении потока магазины сливаются в пул.
+    struct thread_cached_pool {
+        static constexpr std::size_t magazine_size = 32;
+
+        static void *allocate(std::size_t bytes, std::size_t alignment) {
+            detail::chunk_pool &depot = detail::chunk_pool::instance();
+            magazine *mag = detail::chunk_pool::pooled(bytes, alignment) ? local_magazine(bytes) : nullptr;
+            if (mag == nullptr) {
+                return depot.allocate(bytes, alignment);
+            }
+            if (mag->count == 0) {
+                mag->count = depot.allocate_batch(bytes, mag->blocks, magazine_size / 2);
+            }
+            return mag->blocks[--mag->count];
+        }
+
+        static void deallocate(void *p, std::size_t bytes, std::size_t alignment) noexcept {
+            detail::chunk_pool &depot = detail::chunk_pool::instance();
+            magazine *mag = detail::chunk_pool::pooled(bytes, alignment) ? local_magazine(bytes) : nullptr;
+            if (mag == nullptr) {
+                depot.deallocate(p, bytes, alignment);
+                return;
+            }
+            if (mag->count == magazine_size) {
+                mag->count = magazine_size / 2;
+                depot.deallocate_batch(bytes, mag->blocks + mag->count, magazine_size - mag->count);
+            }
+            mag->blocks[mag->count++] = p;
+        }
+
+        // Блоки в магазинах потоков общий пул считает выданными
+        static pool_usage usage() noexcept {
+            return detail::chunk_pool::instance().usage();
+        }
+
+    private:
+        struct magazine {
+            std::size_t count = 0;
+            void *blocks[magazine_size];
+        };
+
+        // Магазины потока по классам размеров, создаются при первом обращении к классу
+        struct thread_cache {
+            std::vector<std::unique_ptr<magazine>> magazines;
+
+            ~thread_cache() {
+                for (std::size_t cls = 0; cls < magazines.size(); ++cls) {
+                    if (magazines[cls] != nullptr) {
+                        detail::chunk_pool::instance().deallocate_batch(
+                                (cls + 1) * detail::chunk_pool::block_granularity,
+                                magazines[cls]->blocks, magazines[cls]->count);
+                    }
+                }
+                finished() = true;
+            }
+        };
+
+        // Признак того, что кэш потока уже разрушен: деструкторы других thread_local объектов
+        // могут освобождать память позже, и тогда она уходит прямо в общий пул
+        static bool &finished() noexcept {
+            thread_local bool value = false;
+            return value;
+        }
+
+        // Магазин текущего потока для класса размера bytes; nullptr, если кэш недоступен
+        static magazine *local_magazine(std::size_t bytes) noexcept {
+            if (finished()) {
+                return nullptr;
+            }
+            thread_local thread_cache cache;
+            std::size_t cls = detail::chunk_pool::class_of(bytes);
+            try {
+                if (cache.magazines.size() <= cls) {
+                    cache.magazines.resize(cls + 1);
+                }
+                if (cache.magazines[cls] == nullptr) {
+                    cache.magazines[cls] = std::make_unique<magazine>();
+                }
+            } catch (...) {
+                return nullptr;
+            }
+            return cache.magazines[cls].get();
+        }
+    };
+
+    /// @brief Аллокатор элементов и чанков ChunkList.
+    /// @tparam Pool источник памяти: shared_pool (по умолчанию) или thread_cached_pool
+    template<typename T, typename Pool = shared_pool>
     class Allocator {
     public:
         using value_type = T;
@@ -18,10 +473,6 @@ namespace fefu_laboratory_two {
         using reference = T &;
         using const_reference = const T &;
 
-    private:
-        size_type n = 0;
-        pointer p;
-
     public:
 
         // Реализация конструктора по умолчанию
@@ -32,32 +483,35 @@ namespace fefu_laboratory_two {
 
         // Реализация конструктора копирования от другого типа
         template<class U>
-        explicit Allocator(const Allocator<U> &other) noexcept {
+        explicit Allocator(const Allocator<U, Pool> &other) noexcept {
         }
 
         // Реализация деструктора
         ~Allocator() = default;
 
-        // Реализация выделения памяти
+        // Реализация выделения памяти. Блоки до chunk_pool::max_block байт (в частности, чанки
+        // ChunkList) берутся из пула Pool, а не из системного аллокатора.
         pointer allocate(size_type n) {
-            this->n = n;
-            auto ptr = static_cast<pointer>(malloc(sizeof(value_type) * n));
-            if (!ptr) {
-                throw std::bad_alloc();
+            if (n > std::numeric_limits<size_type>::max() / sizeof(value_type)) {
+                throw std::bad_array_new_length();
             }
-            p = ptr;
-            return ptr;
+            return static_cast<pointer>(Pool::allocate(sizeof(value_type) * n, alignof(value_type)));
+        }
+
+        // Реализация освобождения памяти, выделенной allocate(n); блоки пула возвращаются в пул
+        void deallocate(pointer p, size_type n) noexcept {
+            Pool::deallocate(p, sizeof(value_type) * n, alignof(value_type));
         }
 
-        // Реализация освобождения памяти
-        void deallocate() noexcept {
-            (void) n;
-            free(p);
+        // Конструирует объект на месте, передавая аргументы без копирования
+        template<typename U, typename... Args>
+        void construct(U *p, Args &&... args) {
+            ::new(static_cast<void *>(p)) U(std::forward<Args>(args)...);
         }
 
-        template<typename... Args>
-        void construct(pointer p, const Args &... args) {
-            new(p) value_type(Args(args)...);
+        template<typename U>
+        void destroy(U *p) noexcept {
+            p->~U();
         }
 
         // Делегированный конструктор, который принимает initializer_list
@@ -65,8 +519,1007 @@ namespace fefu_laboratory_two {
             // Копируем элементы из initializer_list в выделенную память
             std::uninitialized_copy(initList.begin(), initList.end(), p);
         }
+
+        // Объёмы памяти источника Pool: общие для всех аллокаторов с этим источником
+        static pool_usage arena_usage() noexcept {
+            return Pool::usage();
+        }
+
+        // Аллокаторы не хранят состояния, поэтому любые два экземпляра с одним источником
+        // памяти взаимозаменяемы
+        template<class U>
+        friend bool operator==(const Allocator &, const Allocator<U, Pool> &) noexcept {
+            return true;
+        }
+    };
+
+    namespace detail {
+
+        // Заголовок чанка: связи с соседними чанками и количество живых элементов.
+        // Заголовок-страж без элементов, встроенный в ChunkList, замыкает цепочку в кольцо.
+        struct chunk_header {
+            chunk_header *prev;
+            chunk_header *next;
+            std::size_t count;
+            std::size_t head = 0;   // ячейка массива, с которой начинаются элементы; перед ней свободно
+            void *leaf = nullptr;   // лист индекса позиций, в котором записан чанк
+            std::size_t slot = 0;   // место чанка в этом листе
+            std::size_t *hops = nullptr;    // счётчик переходов списка-владельца при включённой статистике
+        };
+
+        // Учитывает переход обхода в чанк node, если список ведёт статистику
+        inline void count_hop(const chunk_header *node) noexcept {
+            if (node->hops != nullptr) {
+                ++*node->hops;
+            }
+        }
+
+        // Размер строки кэша. std::hardware_destructive_interference_size не используется:
+        // его значение зависит от флагов компилятора, а раскладка чанка должна быть одной
+        // во всех единицах трансляции.
+        inline constexpr std::size_t cache_line_size = 64;
+
+        static_assert(sizeof(chunk_header) <= cache_line_size,
+                      "заголовок чанка должен помещаться в одну строку кэша");
+
+        // Выравнивание чанка: не меньше строки кэша и не меньше alignof(T)
+        template<typename T>
+        inline constexpr std::size_t chunk_alignment = std::max(cache_line_size, alignof(T));
+
+        // Смещение массива элементов от начала чанка. Заголовок занимает отдельную строку кэша,
+        // и массив начинается с границы строки, так что соседние чанки не делят строки, а
+        // векторный проход по элементам не начинается с невыровненного хвоста.
+        // Зависит только от T, поэтому итераторам не нужно знать размер чанка N.
+        template<typename T>
+        inline constexpr std::size_t chunk_data_offset =
+                (sizeof(chunk_header) + chunk_alignment<T> - 1) / chunk_alignment<T> * chunk_alignment<T>;
+
+        // Сырая память под один чанк: заголовок и место под N элементов. Начало чанка выровнено
+        // по строке кэша (или по alignof(T), если оно больше).
+        template<typename T, std::size_t N>
+        struct alignas(chunk_alignment<T>) chunk_storage {
+            unsigned char bytes[chunk_data_offset<T> + sizeof(T) * N];
+        };
+
+        // Память под чанк внутри объекта контейнера. Занята, пока used; свободная память
+        // отдаётся первому создаваемому чанку, так что у короткого списка это первый чанк.
+        template<typename Storage, bool Enabled>
+        struct inline_chunk {
+            Storage storage;
+            bool used = false;
+
+            bool owns(const chunk_header *node) const noexcept {
+                return static_cast<const void *>(node) == static_cast<const void *>(&storage);
+            }
+        };
+
+        template<typename Storage>
+        struct inline_chunk<Storage, false> {
+        };
+
+        // Наименьшее число элементов в чанке, подбираемом автоматически: с меньшим числом
+        // чанк вырождается в узел списка
+        inline constexpr std::size_t min_auto_chunk_size = 8;
+
+        // Размер чанка для N = 0: сколько элементов помещается в bytes вместе с заголовком.
+        // Крупные элементы получают бюджет, кратный bytes, чтобы в чанк вошло хотя бы
+        // min_auto_chunk_size элементов.
+        template<typename T>
+        constexpr std::size_t auto_chunk_size(std::size_t bytes) {
+            std::size_t needed = chunk_data_offset<T> + sizeof(T) * min_auto_chunk_size;
+            std::size_t budget = (needed + bytes - 1) / bytes * bytes;
+            return (budget - chunk_data_offset<T>) / sizeof(T);
+        }
+
+        // Указатель на первый элемент чанка
+        template<typename T>
+        T *chunk_data(chunk_header *node) noexcept {
+            return reinterpret_cast<T *>(reinterpret_cast<unsigned char *>(node) + chunk_data_offset<T>) + node->head;
+        }
+
+        // Сдвигает позицию (node, offset) на n элементов, переходя по цепочке чанков.
+        // Внутри чанка сдвиг стоит O(1), каждый пересечённый чанк добавляет один переход.
+        inline void chunk_advance(chunk_header *&node, std::size_t &offset, std::ptrdiff_t n) noexcept {
+            if (n >= 0) {
+                std::size_t target = offset + static_cast<std::size_t>(n);
+                while (node->count != 0 && target >= node->count) {
+                    target -= node->count;
+                    node = node->next;
+                    count_hop(node);
+                }
+                offset = target;
+            } else {
+                auto back = static_cast<std::size_t>(-n);
+                while (back > offset) {
+                    back -= offset;
+                    node = node->prev;
+                    count_hop(node);
+                    offset = node->count;
+                }
+                offset -= back;
+            }
+        }
+
+        // Число элементов от позиции (from, from_offset) до (to, to_offset); отрицательно, если to
+        // стоит раньше. Цепочка просматривается вперёд сразу от обеих позиций, поэтому стоимость
+        // пропорциональна числу чанков между ними, а не длине всего списка.
+        inline std::ptrdiff_t chunk_distance(const chunk_header *from, std::size_t from_offset,
+                                             const chunk_header *to, std::size_t to_offset) noexcept {
+            if (from == to) {
+                return static_cast<std::ptrdiff_t>(to_offset) - static_cast<std::ptrdiff_t>(from_offset);
+            }
+            auto forward = static_cast<std::ptrdiff_t>(from->count - from_offset);
+            auto backward = static_cast<std::ptrdiff_t>(to->count - to_offset);
+            // От стража (позиции end()) вперёд идти некуда
+            const chunk_header *a = from->count != 0 ? from->next : nullptr;
+            const chunk_header *b = to->count != 0 ? to->next : nullptr;
+            while (true) {
+                if (a != nullptr) {
+                    if (a == to) {
+                        return forward + static_cast<std::ptrdiff_t>(to_offset);
+                    }
+                    forward += static_cast<std::ptrdiff_t>(a->count);
+                    a = a->count != 0 ? a->next : nullptr;
+                }
+                if (b != nullptr) {
+                    if (b == from) {
+                        return -(backward + static_cast<std::ptrdiff_t>(from_offset));
+                    }
+                    backward += static_cast<std::ptrdiff_t>(b->count);
+                    b = b->count != 0 ? b->next : nullptr;
+                }
+            }
+        }
+
+        // Упорядочивает две позиции одного списка. Сравнение с end() не требует обхода цепочки.
+        inline std::strong_ordering chunk_compare(const chunk_header *lhs, std::size_t lhs_offset,
+                                                  const chunk_header *rhs, std::size_t rhs_offset) noexcept {
+            if (lhs == rhs) {
+                return lhs_offset <=> rhs_offset;
+            }
+            if (lhs->count == 0) {
+                return std::strong_ordering::greater;
+            }
+            if (rhs->count == 0) {
+                return std::strong_ordering::less;
+            }
+            return 0 <=> chunk_distance(lhs, lhs_offset, rhs, rhs_offset);
+        }
+
+        // Индекс позиций: B-дерево над цепочкой чанков в её порядке. Лист хранит чанки, внутренний
+        // узел - дочерние узлы, и каждый узел знает число элементов в поддереве каждого ребёнка.
+        // Поиск элемента по номеру, изменение размера чанка, вставка и удаление чанка в любом
+        // месте цепочки стоят O(log C), так что индекс поддерживается изменяющими операциями и
+        // никогда не перестраивается при чтении. Чанк помнит свой лист (chunk_header::leaf).
+        // Узлы выделяются аллокатором списка, который передаётся в операции: дерево переходит
+        // к другому списку вместе с цепочкой чанков. Нехватка памяти не выбрасывается наружу,
+        // а выключает индекс до следующей перестройки.
+        template<class Allocator>
+        class chunk_index {
+            // Число детей узла: поиск просматривает их подряд, поэтому узел невелик
+            static constexpr std::size_t fanout = 16;
+            // Заполнение узлов при перестройке: остаётся место для вставок без деления
+            static constexpr std::size_t build_fill = fanout * 3 / 4;
+            // Узел, у которого после удаления осталось меньше детей, выравнивается с соседом
+            static constexpr std::size_t min_fill = fanout / 4;
+
+            // Узел выровнен по строке кэша: поиск просматривает counts подряд
+            struct alignas(cache_line_size) node {
+                node *parent;
+                std::size_t slot;            // место узла в родителе
+                std::size_t size;            // число детей
+                bool leaf;
+                std::size_t counts[fanout];  // число элементов в поддереве каждого ребёнка
+                void *children[fanout];      // чанки у листа, узлы у внутреннего узла
+            };
+
+            using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<node>;
+            using node_traits = std::allocator_traits<node_allocator>;
+
+            node *root = nullptr;
+            // Заранее выделенные узлы для делений при вставке, связаны через parent
+            node *spare = nullptr;
+            std::size_t spares = 0;
+            std::size_t nodes = 0;
+            std::size_t height = 0;
+
+            static node *leaf_of(const chunk_header *chunk) noexcept {
+                return static_cast<node *>(chunk->leaf);
+            }
+
+            static std::size_t total(const node *n) noexcept {
+                std::size_t sum = 0;
+                for (std::size_t i = 0; i < n->size; ++i) {
+                    sum += n->counts[i];
+                }
+                return sum;
+            }
+
+            // Записывает в ребёнка i узла n обратную ссылку на n и его место в n
+            static void adopt(node *n, std::size_t i) noexcept {
+                if (n->leaf) {
+                    auto *chunk = static_cast<chunk_header *>(n->children[i]);
+                    chunk->leaf = n;
+                    chunk->slot = i;
+                } else {
+                    auto *child = static_cast<node *>(n->children[i]);
+                    child->parent = n;
+                    child->slot = i;
+                }
+            }
+
+            // Пополняет запас узлов до count; исключение оставляет дерево нетронутым
+            void reserve(const Allocator &alloc, std::size_t count) {
+                node_allocator node_alloc(alloc);
+                while (spares < count) {
+                    node *n = node_traits::allocate(node_alloc, 1);
+                    n->parent = spare;
+                    spare = n;
+                    ++spares;
+                    ++nodes;
+                }
+            }
+
+            node *take_spare(bool leaf) noexcept {
+                node *n = spare;
+                spare = n->parent;
+                --spares;
+                n->parent = nullptr;
+                n->size = 0;
+                n->leaf = leaf;
+                return n;
+            }
+
+            void deallocate(const Allocator &alloc, node *n) noexcept {
+                node_allocator node_alloc(alloc);
+                node_traits::deallocate(node_alloc, n, 1);
+                --nodes;
+            }
+
+            void free_subtree(const Allocator &alloc, node *n) noexcept {
+                if (!n->leaf) {
+                    for (std::size_t i = 0; i < n->size; ++i) {
+                        free_subtree(alloc, static_cast<node *>(n->children[i]));
+                    }
+                }
+                deallocate(alloc, n);
+            }
+
+            static void put(node *n, std::size_t i, void *child, std::size_t count) noexcept {
+                for (std::size_t j = n->size; j > i; --j) {
+                    n->children[j] = n->children[j - 1];
+                    n->counts[j] = n->counts[j - 1];
+                    adopt(n, j);
+                }
+                n->children[i] = child;
+                n->counts[i] = count;
+                ++n->size;
+                adopt(n, i);
+            }
+
+            // Убирает ребёнка i узла n, сдвигая следующих
+            static void remove_at(node *n, std::size_t i) noexcept {
+                for (std::size_t j = i; j + 1 < n->size; ++j) {
+                    n->children[j] = n->children[j + 1];
+                    n->counts[j] = n->counts[j + 1];
+                    adopt(n, j);
+                }
+                --n->size;
+            }
+
+            // Выравнивает узел n (не корень), в котором осталось меньше min_fill детей. Пустой
+            // узел убирается из родителя; иначе n сливается с соседом, если их дети помещаются
+            // в один узел, или забирает у соседа половину разницы. Возвращает true, если
+            // родитель потерял ребёнка и сам может стать недозаполненным.
+            bool rebalance(const Allocator &alloc, node *n) noexcept {
+                node *parent = n->parent;
+                if (n->size == 0) {
+                    remove_at(parent, n->slot);
+                    deallocate(alloc, n);
+                    return true;
+                }
+                if (parent->size == 1) {
+                    return false;
+                }
+                std::size_t k = n->slot == 0 ? 0 : n->slot - 1;
+                auto *left = static_cast<node *>(parent->children[k]);
+                auto *right = static_cast<node *>(parent->children[k + 1]);
+                if (left->size + right->size <= fanout) {
+                    for (std::size_t j = 0; j < right->size; ++j) {
+                        left->children[left->size] = right->children[j];
+                        left->counts[left->size] = right->counts[j];
+                        adopt(left, left->size++);
+                    }
+                    parent->counts[k] += parent->counts[k + 1];
+                    remove_at(parent, k + 1);
+                    deallocate(alloc, right);
+                    return true;
+                }
+                std::size_t moved = 0;
+                if (left == n) {
+                    std::size_t m = (right->size - left->size) / 2;
+                    for (std::size_t j = 0; j < m; ++j) {
+                        left->children[left->size] = right->children[j];
+                        left->counts[left->size] = right->counts[j];
+                        moved += right->counts[j];
+                        adopt(left, left->size++);
+                    }
+                    for (std::size_t j = m; j < right->size; ++j) {
+                        right->children[j - m] = right->children[j];
+                        right->counts[j - m] = right->counts[j];
+                        adopt(right, j - m);
+                    }
+                    right->size -= m;
+                    parent->counts[k] += moved;
+                    parent->counts[k + 1] -= moved;
+                } else {
+                    std::size_t m = (left->size - right->size) / 2;
+                    for (std::size_t j = right->size; j-- > 0;) {
+                        right->children[j + m] = right->children[j];
+                        right->counts[j + m] = right->counts[j];
+                        adopt(right, j + m);
+                    }
+                    for (std::size_t j = 0; j < m; ++j) {
+                        right->children[j] = left->children[left->size - m + j];
+                        right->counts[j] = left->counts[left->size - m + j];
+                        moved += right->counts[j];
+                        adopt(right, j);
+                    }
+                    left->size -= m;
+                    right->size += m;
+                    parent->counts[k] -= moved;
+                    parent->counts[k + 1] += moved;
+                }
+                return false;
+            }
+
+            // Вставляет ребёнка child с count элементами на место i узла n; суммы предков n уже
+            // учитывают эти элементы. Полный узел делится, правая часть вставляется в родителя
+            // (при необходимости - в новый корень). Вставка в середину делит узел пополам,
+            // а вставка в край оставляет полным прежний узел: при дописывании в конец или
+            // начало цепочки узлы заполняются целиком, и дерево остаётся низким.
+            void place(node *n, std::size_t i, void *child, std::size_t count) noexcept {
+                if (n->size < fanout) {
+                    put(n, i, child, count);
+                    return;
+                }
+                std::size_t half = i == 0 ? 0 : i == fanout ? fanout : fanout / 2;
+                node *right = take_spare(n->leaf);
+                for (std::size_t j = half; j < fanout; ++j) {
+                    right->children[j - half] = n->children[j];
+                    right->counts[j - half] = n->counts[j];
+                    adopt(right, j - half);
+                }
+                right->size = fanout - half;
+                n->size = half;
+                if (i > half || half == fanout) {
+                    put(right, i - half, child, count);
+                } else {
+                    put(n, i, child, count);
+                }
+                std::size_t moved = total(right);
+                if (n->parent == nullptr) {
+                    node *top = take_spare(false);
+                    put(top, 0, n, total(n));
+                    put(top, 1, right, moved);
+                    root = top;
+                    ++height;
+                } else {
+                    n->parent->counts[n->slot] -= moved;
+                    place(n->parent, n->slot + 1, right, moved);
+                }
+            }
+
+        public:
+            chunk_index() = default;
+            chunk_index(const chunk_index &) = delete;
+            chunk_index &operator=(const chunk_index &) = delete;
+
+            // Индекс ведётся, пока в цепочке больше двух чанков и хватило памяти на узлы
+            bool active() const noexcept {
+                return root != nullptr;
+            }
+
+            // Освобождает все узлы; индекс выключается
+            void reset(const Allocator &alloc) noexcept {
+                if (root != nullptr) {
+                    free_subtree(alloc, root);
+                    root = nullptr;
+                }
+                while (spare != nullptr) {
+                    node *next = spare->parent;
+                    deallocate(alloc, spare);
+                    spare = next;
+                }
+                spares = 0;
+                height = 0;
+            }
+
+            // Строит индекс заново по цепочке чанков стража sentinel за O(C)
+            void rebuild(const Allocator &alloc, const chunk_header *sentinel) noexcept {
+                reset(alloc);
+                std::size_t level_size = 0;
+                for (const chunk_header *chunk = sentinel->next; chunk != sentinel; chunk = chunk->next) {
+                    ++level_size;
+                }
+                std::size_t needed = 0;
+                do {
+                    level_size = std::max<std::size_t>((level_size + build_fill - 1) / build_fill, 1);
+                    needed += level_size;
+                } while (level_size > 1);
+                try {
+                    reserve(alloc, needed);
+                } catch (...) {
+                    reset(alloc);
+                    return;
+                }
+                // Узлы уровня связываются через parent, пока не получат настоящего родителя
+                node *level = nullptr;
+                node **tail = &level;
+                node *current = nullptr;
+                for (chunk_header *chunk = sentinel->next; chunk != sentinel; chunk = chunk->next) {
+                    if (current == nullptr || current->size == build_fill) {
+                        current = take_spare(true);
+                        *tail = current;
+                        tail = &current->parent;
+                    }
+                    current->children[current->size] = chunk;
+                    current->counts[current->size] = chunk->count;
+                    adopt(current, current->size++);
+                }
+                if (level == nullptr) {
+                    level = take_spare(true);
+                }
+                height = 1;
+                while (level->parent != nullptr) {
+                    node *upper = nullptr;
+                    node **upper_tail = &upper;
+                    current = nullptr;
+                    for (node *child = level; child != nullptr;) {
+                        node *next = child->parent;
+                        if (current == nullptr || current->size == build_fill) {
+                            current = take_spare(false);
+                            *upper_tail = current;
+                            upper_tail = &current->parent;
+                        }
+                        current->children[current->size] = child;
+                        current->counts[current->size] = total(child);
+                        adopt(current, current->size++);
+                        child = next;
+                    }
+                    level = upper;
+                    ++height;
+                }
+                root = level;
+            }
+
+            // Вносит чанк chunk, только что вставленный в цепочку следом за чанком after
+            // (nullptr - в начало)
+            void insert(const Allocator &alloc, chunk_header *chunk, const chunk_header *after) noexcept {
+                if (root == nullptr) {
+                    return;
+                }
+                try {
+                    reserve(alloc, height + 1);
+                } catch (...) {
+                    reset(alloc);
+                    return;
+                }
+                node *n;
+                std::size_t i;
+                if (after != nullptr) {
+                    n = leaf_of(after);
+                    i = after->slot + 1;
+                } else {
+                    n = root;
+                    while (!n->leaf) {
+                        n = static_cast<node *>(n->children[0]);
+                    }
+                    i = 0;
+                }
+                for (node *child = n; child->parent != nullptr; child = child->parent) {
+                    child->parent->counts[child->slot] += chunk->count;
+                }
+                place(n, i, chunk, chunk->count);
+            }
+
+            // Убирает чанк chunk. Недозаполненные узлы сливаются с соседями или забирают у них
+            // детей, корень с одним ребёнком заменяется этим ребёнком, так что после массовых
+            // удалений высота дерева снова соответствует текущему числу чанков.
+            void erase(const Allocator &alloc, chunk_header *chunk) noexcept {
+                if (root == nullptr) {
+                    return;
+                }
+                add(chunk, -static_cast<std::ptrdiff_t>(chunk->count));
+                node *n = leaf_of(chunk);
+                remove_at(n, chunk->slot);
+                while (n != root && n->size < min_fill) {
+                    node *parent = n->parent;
+                    if (!rebalance(alloc, n)) {
+                        break;
+                    }
+                    n = parent;
+                }
+                if (root->size == 0) {
+                    // Опустевшее дерево - пустой лист
+                    root->leaf = true;
+                    height = 1;
+                }
+                while (!root->leaf && root->size == 1) {
+                    node *top = root;
+                    root = static_cast<node *>(top->children[0]);
+                    root->parent = nullptr;
+                    deallocate(alloc, top);
+                    --height;
+                }
+            }
+
+            // Переносит запись чанка from на чанк to, занявший его место в цепочке
+            void replace(const chunk_header *from, chunk_header *to) noexcept {
+                if (root == nullptr) {
+                    return;
+                }
+                node *n = leaf_of(from);
+                n->children[from->slot] = to;
+                adopt(n, from->slot);
+            }
+
+            // Забирает дерево other вместе с цепочкой его чанков; свой индекс отдаёт other
+            void take(chunk_index &other) noexcept {
+                std::swap(root, other.root);
+                std::swap(spare, other.spare);
+                std::swap(spares, other.spares);
+                std::swap(nodes, other.nodes);
+                std::swap(height, other.height);
+            }
+
+            // Учитывает изменение размера чанка chunk на delta элементов
+            void add(const chunk_header *chunk, std::ptrdiff_t delta) noexcept {
+                if (root == nullptr) {
+                    return;
+                }
+                node *n = leaf_of(chunk);
+                n->counts[chunk->slot] += static_cast<std::size_t>(delta);
+                for (; n->parent != nullptr; n = n->parent) {
+                    n->parent->counts[n->slot] += static_cast<std::size_t>(delta);
+                }
+            }
+
+            // Память, занятая узлами индекса
+            std::size_t bytes() const noexcept {
+                return nodes * sizeof(node);
+            }
+
+            // Чанк, содержащий элемент с номером pos, и смещение элемента в нём. Индекс должен
+            // быть включён, pos - меньше числа элементов.
+            std::pair<chunk_header *, std::size_t> find(std::size_t pos) const noexcept {
+                const node *n = root;
+                while (true) {
+                    std::size_t i = 0;
+                    while (pos >= n->counts[i]) {
+                        pos -= n->counts[i];
+                        ++i;
+                    }
+                    if (n->leaf) {
+                        return {static_cast<chunk_header *>(n->children[i]), pos};
+                    }
+                    n = static_cast<const node *>(n->children[i]);
+                }
+            }
+
+            // Число элементов в чанках перед chunk. Индекс должен быть включён.
+            std::size_t rank(const chunk_header *chunk) const noexcept {
+                const node *n = leaf_of(chunk);
+                std::size_t before = 0;
+                for (std::size_t i = 0; i < chunk->slot; ++i) {
+                    before += n->counts[i];
+                }
+                for (; n->parent != nullptr; n = n->parent) {
+                    for (std::size_t i = 0; i < n->slot; ++i) {
+                        before += n->parent->counts[i];
+                    }
+                }
+                return before;
+            }
+        };
+
+        // Ограничение для шаблонных перегрузок, принимающих диапазон входных итераторов
+        template<class InputIt>
+        using enable_if_input_iterator = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category>>;
+    }
+
+    namespace detail::simd {
+
+        // Типы элементов, для которых есть векторные ядра. Целые сравниваются побитово, float и
+        // double - так же, как оператор == (NaN не равен ничему, -0 равен +0).
+        template<typename T>
+        inline constexpr bool is_int32 = std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) == 4;
+
+        template<typename T>
+        inline constexpr bool is_int64 = std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) == 8;
+
+        template<typename T>
+        inline constexpr bool is_real = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+        // find и count
+        template<typename T>
+        inline constexpr bool searchable = is_int32<T> || is_int64<T> || is_real<T>;
+
+        // min_element и max_element
+        template<typename T>
+        inline constexpr bool orderable = is_int32<T> || is_real<T>;
+
+#if CHUNK_LIST_X86_SIMD
+#define CHUNK_LIST_TARGET_AVX2 __attribute__((target("avx2")))
+
+        // Поддержка AVX2 проверяется один раз; SSE2 входит в базовый набор x86-64.
+        // CHUNK_LIST_NO_AVX2 отключает ядра AVX2, чтобы путь SSE2 можно было проверить и на
+        // процессоре с AVX2.
+        inline bool has_avx2() noexcept {
+#ifdef CHUNK_LIST_NO_AVX2
+            return false;
+#else
+            static const bool value = [] {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2") != 0;
+            }();
+            return value;
+#endif
+        }
+
+        template<typename T>
+        CHUNK_LIST_TARGET_AVX2 inline __m256i avx2_load(const T *p) {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        }
+
+        template<typename T>
+        CHUNK_LIST_TARGET_AVX2 inline __m256i avx2_splat(T value) {
+            if constexpr (std::is_same_v<T, float>) {
+                return _mm256_castps_si256(_mm256_set1_ps(value));
+            } else if constexpr (std::is_same_v<T, double>) {
+                return _mm256_castpd_si256(_mm256_set1_pd(value));
+            } else if constexpr (sizeof(T) == 4) {
+                return _mm256_set1_epi32(static_cast<int>(value));
+            } else {
+                return _mm256_set1_epi64x(static_cast<long long>(value));
+            }
+        }
+
+        // Маска равных дорожек: все биты дорожки установлены, если элементы равны
+        template<typename T>
+        CHUNK_LIST_TARGET_AVX2 inline __m256i avx2_equal(__m256i a, __m256i b) {
+            if constexpr (std::is_same_v<T, float>) {
+                return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+            } else if constexpr (std::is_same_v<T, double>) {
+                return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+            } else if constexpr (sizeof(T) == 4) {
+                return _mm256_cmpeq_epi32(a, b);
+            } else {
+                return _mm256_cmpeq_epi64(a, b);
+            }
+        }
+
+        template<typename T>
+        CHUNK_LIST_TARGET_AVX2 const T *avx2_find(const T *first, const T *last, T value) {
+            constexpr std::ptrdiff_t lanes = 32 / sizeof(T);
+            const __m256i needle = avx2_splat(value);
+            for (; last - first >= lanes; first += lanes) {
+                auto mask = static_cast<unsigned>(_mm256_movemask_epi8(avx2_equal<T>(avx2_load(first), needle)));
+                if (mask != 0) {
+                    return first + std::countr_zero(mask) / sizeof(T);
+                }
+            }
+            while (first != last && !(*first == value)) {
+                ++first;
+            }
+            return first;
+        }
+
+        template<typename T>
+        CHUNK_LIST_TARGET_AVX2 std::size_t avx2_count(const T *first, const T *last, T value) {
+            constexpr std::ptrdiff_t lanes = 32 / sizeof(T);
+            const __m256i needle = avx2_splat(value);
+            // Равная дорожка даёт -1, вычитание прибавляет к счётчику дорожки единицу
+            __m256i counters = _mm256_setzero_si256();
+            for (; last - first >= lanes; first += lanes) {
+                __m256i equal = avx2_equal<T>(avx2_load(first), needle);
+                counters = sizeof(T) == 4 ? _mm256_sub_epi32(counters, equal) : _mm256_sub_epi64(counters, equal);
+            }
+            alignas(32) std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t> lane[lanes];
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lane), counters);
+            std::size_t result = 0;
+            for (auto c: lane) {
+                result += c;
+            }
+            for (; first != last; ++first) {
+                result += *first == value;
+            }
+            return result;
+        }
+
+        template<typename T, bool Max>
+        CHUNK_LIST_TARGET_AVX2 inline __m256i avx2_pick(__m256i a, __m256i b) {
+            if constexpr (std::is_same_v<T, float>) {
+                __m256 x = _mm256_castsi256_ps(a);
+                __m256 y = _mm256_castsi256_ps(b);
+                return _mm256_castps_si256(Max ? _mm256_max_ps(x, y) : _mm256_min_ps(x, y));
+            } else if constexpr (std::is_same_v<T, double>) {
+                __m256d x = _mm256_castsi256_pd(a);
+                __m256d y = _mm256_castsi256_pd(b);
+                return _mm256_castpd_si256(Max ? _mm256_max_pd(x, y) : _mm256_min_pd(x, y));
+            } else if constexpr (std::is_signed_v<T>) {
+                return Max ? _mm256_max_epi32(a, b) : _mm256_min_epi32(a, b);
+            } else {
+                return Max ? _mm256_max_epu32(a, b) : _mm256_min_epu32(a, b);
+            }
+        }
+
+        // Дорожки, в которых лежит NaN
+        template<typename T>
+        CHUNK_LIST_TARGET_AVX2 inline __m256i avx2_unordered(__m256i a) {
+            if constexpr (std::is_same_v<T, float>) {
+                __m256 x = _mm256_castsi256_ps(a);
+                return _mm256_castps_si256(_mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+            } else if constexpr (std::is_same_v<T, double>) {
+                __m256d x = _mm256_castsi256_pd(a);
+                return _mm256_castpd_si256(_mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+            } else {
+                return _mm256_setzero_si256();
+            }
+        }
+
+        // Первый наименьший (наибольший) элемент, как у std::min_element (std::max_element).
+        // Сначала векторно находится само значение, затем его первое вхождение. Диапазон с
+        // NaN обрабатывается скалярно: векторные min/max упорядочивают NaN иначе, чем оператор <.
+        template<typename T, bool Max>
+        CHUNK_LIST_TARGET_AVX2 const T *avx2_extremum(const T *first, const T *last) {
+            constexpr std::ptrdiff_t lanes = 32 / sizeof(T);
+            if (last - first < 2 * lanes) {
+                return Max ? std::max_element(first, last) : std::min_element(first, last);
+            }
+            __m256i best = avx2_load(first);
+            __m256i unordered = avx2_unordered<T>(best);
+            const T *p = first + lanes;
+            for (; last - p >= lanes; p += lanes) {
+                __m256i values = avx2_load(p);
+                best = avx2_pick<T, Max>(best, values);
+                unordered = _mm256_or_si256(unordered, avx2_unordered<T>(values));
+            }
+            bool has_nan = !_mm256_testz_si256(unordered, unordered);
+            for (const T *q = p; q != last; ++q) {
+                has_nan |= !(*q == *q);
+            }
+            if (has_nan) {
+                return Max ? std::max_element(first, last) : std::min_element(first, last);
+            }
+            alignas(32) T lane[lanes];
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lane), best);
+            T value = lane[0];
+            for (std::ptrdiff_t i = 1; i < lanes; ++i) {
+                value = Max ? std::max(value, lane[i]) : std::min(value, lane[i]);
+            }
+            for (; p != last; ++p) {
+                value = Max ? std::max(value, *p) : std::min(value, *p);
+            }
+            return avx2_find(first, last, value);
+        }
+
+        // Сумма 32-битных целых по модулю 2^64; знаковые расширяются со знаком
+        template<typename T>
+        CHUNK_LIST_TARGET_AVX2 std::uint64_t avx2_sum(const T *first, const T *last) {
+            __m256i sums = _mm256_setzero_si256();
+            for (; last - first >= 8; first += 8) {
+                __m256i values = avx2_load(first);
+                __m128i low = _mm256_castsi256_si128(values);
+                __m128i high = _mm256_extracti128_si256(values, 1);
+                if constexpr (std::is_signed_v<T>) {
+                    sums = _mm256_add_epi64(sums, _mm256_add_epi64(_mm256_cvtepi32_epi64(low),
+                                                                   _mm256_cvtepi32_epi64(high)));
+                } else {
+                    sums = _mm256_add_epi64(sums, _mm256_add_epi64(_mm256_cvtepu32_epi64(low),
+                                                                   _mm256_cvtepu32_epi64(high)));
+                }
+            }
+            alignas(32) std::uint64_t lane[4];
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lane), sums);
+            std::uint64_t result = lane[0] + lane[1] + lane[2] + lane[3];
+            for (; first != last; ++first) {
+                result += static_cast<std::uint64_t>(static_cast<std::int64_t>(*first));
+            }
+            return result;
+        }
+
+#undef CHUNK_LIST_TARGET_AVX2
+
+        // Вариант SSE2 для процессоров без AVX2: только поиск и подсчёт 32-битных целых,
+        // float и double (сравнения 64-битных целых в SSE2 нет)
+        template<typename T>
+        inline constexpr bool sse2_searchable = is_int32<T> || is_real<T>;
+
+        template<typename T>
+        inline __m128i sse2_equal(const T *p, T value) {
+            if constexpr (std::is_same_v<T, float>) {
+                return _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(p), _mm_set1_ps(value)));
+            } else if constexpr (std::is_same_v<T, double>) {
+                return _mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(p), _mm_set1_pd(value)));
+            } else {
+                return _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)),
+                                       _mm_set1_epi32(static_cast<int>(value)));
+            }
+        }
+
+        template<typename T>
+        const T *sse2_find(const T *first, const T *last, T value) {
+            constexpr std::ptrdiff_t lanes = 16 / sizeof(T);
+            for (; last - first >= lanes; first += lanes) {
+                auto mask = static_cast<unsigned>(_mm_movemask_epi8(sse2_equal(first, value)));
+                if (mask != 0) {
+                    return first + std::countr_zero(mask) / sizeof(T);
+                }
+            }
+            while (first != last && !(*first == value)) {
+                ++first;
+            }
+            return first;
+        }
+
+        template<typename T>
+        std::size_t sse2_count(const T *first, const T *last, T value) {
+            constexpr std::ptrdiff_t lanes = 16 / sizeof(T);
+            std::size_t result = 0;
+            for (; last - first >= lanes; first += lanes) {
+                auto mask = static_cast<unsigned>(_mm_movemask_epi8(sse2_equal(first, value)));
+                result += static_cast<std::size_t>(std::popcount(mask)) / sizeof(T);
+            }
+            for (; first != last; ++first) {
+                result += *first == value;
+            }
+            return result;
+        }
+#endif
+
+        // Точки входа: выбирают AVX2, SSE2 или скалярный вариант. Векторный путь берётся,
+        // только если искомое значение имеет тот же тип, что и элементы, иначе сравнение
+        // после приведения типа могло бы дать другой результат.
+        template<typename T, typename U>
+        T *find(T *first, T *last, const U &value) {
+            using V = std::remove_const_t<T>;
+            if constexpr (searchable<V> && std::is_same_v<U, V>) {
+#if CHUNK_LIST_X86_SIMD
+                if (has_avx2()) {
+                    return const_cast<T *>(avx2_find<V>(first, last, value));
+                }
+                if constexpr (sse2_searchable<V>) {
+                    return const_cast<T *>(sse2_find<V>(first, last, value));
+                }
+#endif
+            }
+            return std::find(first, last, value);
+        }
+
+        template<typename T, typename U>
+        std::size_t count(const T *first, const T *last, const U &value) {
+            using V = std::remove_const_t<T>;
+            if constexpr (searchable<V> && std::is_same_v<U, V>) {
+#if CHUNK_LIST_X86_SIMD
+                if (has_avx2()) {
+                    return avx2_count<V>(first, last, value);
+                }
+                if constexpr (sse2_searchable<V>) {
+                    return sse2_count<V>(first, last, value);
+                }
+#endif
+            }
+            return static_cast<std::size_t>(std::count(first, last, value));
+        }
+
+        template<bool Max, typename T>
+        T *extremum(T *first, T *last) {
+            using V = std::remove_const_t<T>;
+            if constexpr (orderable<V>) {
+#if CHUNK_LIST_X86_SIMD
+                if (has_avx2()) {
+                    return const_cast<T *>(avx2_extremum<V, Max>(first, last));
+                }
+#endif
+            }
+            return Max ? std::max_element(first, last) : std::min_element(first, last);
+        }
+
+        // Свёртку можно считать векторно только для сложения 32-битных целых с целым
+        // начальным значением: результат по модулю совпадает с последовательным. Для float и
+        // double порядок сложения меняет округление, поэтому они суммируются по порядку.
+        // std::plus<T> приводит каждую промежуточную сумму к T, поэтому с более широким
+        // начальным значением он переполняется там, где 64-битная сумма нет: допускается
+        // только Init == T.
+        template<typename T, typename Init, typename BinaryOperation>
+        inline constexpr bool summable = is_int32<T> && std::is_integral_v<Init> && !std::is_same_v<Init, bool> &&
+                                         (std::is_same_v<BinaryOperation, std::plus<>> ||
+                                          (std::is_same_v<BinaryOperation, std::plus<T>> &&
+                                           std::is_same_v<Init, T>));
+
+        template<typename T, typename Init, typename BinaryOperation>
+        Init accumulate(const T *first, const T *last, Init init, BinaryOperation op) {
+            using V = std::remove_const_t<T>;
+            if constexpr (summable<V, Init, BinaryOperation>) {
+#if CHUNK_LIST_X86_SIMD
+                if (has_avx2()) {
+                    return static_cast<Init>(static_cast<std::uint64_t>(init) + avx2_sum<V>(first, last));
+                }
+#endif
+            }
+            return std::accumulate(first, last, std::move(init), op);
+        }
+    }
+
+    /// @brief Политика вставки в заполненный чанк: чанк делится пополам, и обе половины
+    /// получают запас под следующие вставки. Подходит для произвольного редактирования.
+    struct split_fill {
+    };
+
+    /// @brief Политика вставки в заполненный чанк: крайний элемент перекладывается в соседний
+    /// чанк со свободным местом (туда, где меньше сдвигов), чанк делится только если места нет
+    /// у обоих соседей. Даёт наибольшую плотность чанков.
+    struct spill_fill {
+    };
+
+    /// @brief Политика вставки в заполненный чанк: элементы после позиции вставки уносятся в
+    /// новый чанк, а при вставке в начало чанка новый элемент получает собственный чанк.
+    /// Сдвигов меньше всего, при дописывании в конец чанки остаются заполненными полностью.
+    struct fresh_fill {
+    };
+
+    /// @brief Политика статистики по умолчанию: счётчики не ведутся и не занимают места.
+    struct no_stats {
+        static constexpr bool enabled = false;
+    };
+
+    /// @brief Политика статистики со счётчиками операций ChunkList. Показывает, на что уходит
+    /// время контейнера: на выделение памяти, на сдвиги элементов или на переходы по цепочке.
+    /// Переходы считаются и при чтении, поэтому список со статистикой нельзя обходить из
+    /// нескольких потоков одновременно.
+    struct chunk_list_stats {
+        static constexpr bool enabled = true;
+        std::size_t chunk_allocations = 0;  // выделенные чанки, включая встроенный
+        std::size_t chunk_frees = 0;        // освобождённые чанки
+        std::size_t element_shifts = 0;     // перемещения элементов при вставке, удалении и уплотнении
+        std::size_t chunk_hops = 0;         // переходы обхода из чанка в чанк: итераторы, chunks(),
+                                            // сегментные алгоритмы, поиск позиции и курсоры
+    };
+
+    /// @brief Параметры ChunkList по умолчанию. Чтобы изменить отдельный параметр, достаточно
+    /// унаследоваться и переопределить его:
+    /// struct my_options : chunk_list_options { using fill_policy = spill_fill; };
+    struct chunk_list_options {
+        using fill_policy = split_fill;
+        // Бюджет памяти одного чанка вместе с заголовком, используется при N = 0.
+        // Страница памяти: чанк целиком попадает в один класс размеров пула.
+        static constexpr std::size_t chunk_bytes = 4096;
+        // Встроить память под один чанк в сам объект ChunkList: списки не длиннее N
+        // обходятся без обращений к аллокатору. Увеличивает sizeof(ChunkList) на размер чанка,
+        // поэтому предназначено для небольших N.
+        static constexpr bool inline_first_chunk = false;
+        // Чанки с зазором: свободное место чанка может лежать и перед элементами, и после них.
+        // Вставка и удаление сдвигают меньшую из двух частей чанка, так что правка стоит
+        // O(расстояние до ближнего края), а у краёв чанка - O(1). Заполненный чанк делится
+        // ровно в точке вставки (fill_policy не используется): слева остаётся место для
+        // следующих вставок в ту же позицию, справа - для удалений за ней.
+        static constexpr bool gap_chunks = false;
+        // Счётчики операций: no_stats или chunk_list_stats
+        using stats = no_stats;
     };
 
+    template<typename T, int N, typename Allocator, typename Options>
+    class ChunkList;
+
+    template<typename ValueType>
+    class ChunkList_const_iterator;
+
+    namespace detail {
+        struct segment_access;
+    }
+
     template<typename ValueType>
     class ChunkList_iterator {
     public:
@@ -76,24 +1529,31 @@ namespace fefu_laboratory_two {
         using pointer = ValueType *;
         using reference = ValueType &;
     private:
-        pointer iterator;
+        // Итератор хранит чанк и смещение внутри него; end() указывает на стража со смещением 0
+        detail::chunk_header *node = nullptr;
+        std::size_t offset = 0;
+
+        template<typename, int, typename, typename>
+        friend class ChunkList;
+
+        friend class ChunkList_const_iterator<ValueType>;
+        friend struct detail::segment_access;
     public:
 
         // Реализация конструктора по умолчанию
         ChunkList_iterator() noexcept = default;
 
-        ChunkList_iterator(pointer p) noexcept {
-            iterator = p;
-        };
+        ChunkList_iterator(detail::chunk_header *node, std::size_t offset) noexcept
+                : node(node), offset(offset) {
+        }
 
         // Реализация конструктора копирования
-        ChunkList_iterator(const ChunkList_iterator &other) noexcept {
-
-        }
+        ChunkList_iterator(const ChunkList_iterator &other) noexcept = default;
 
         // Реализация оператора присваивания
         ChunkList_iterator &operator=(const ChunkList_iterator &other) {
-            iterator = other.iterator;
+            node = other.node;
+            offset = other.offset;
             return *this;
         }
 
@@ -102,291 +1562,1293 @@ namespace fefu_laboratory_two {
 
         // Реализация функции swap
         friend void swap(ChunkList_iterator<ValueType> &lhs, ChunkList_iterator<ValueType> &rhs) {
-
+            std::swap(lhs.node, rhs.node);
+            std::swap(lhs.offset, rhs.offset);
         }
 
         // Реализация оператора ==
         friend bool operator==(const ChunkList_iterator<ValueType> &lhs,
                                const ChunkList_iterator<ValueType> &rhs) {
-            return lhs.iterator == rhs.iterator;
+            return lhs.node == rhs.node && lhs.offset == rhs.offset;
         }
 
         // Реализация оператора !=
         friend bool operator!=(const ChunkList_iterator<ValueType> &lhs,
                                const ChunkList_iterator<ValueType> &rhs) {
-            return lhs.iterator != rhs.iterator;
+            return !(lhs == rhs);
+        }
+
+        // Реализация оператора разыменования *
+        reference operator*() const {
+            return detail::chunk_data<ValueType>(node)[offset];
+        }
+
+        // Реализация оператора ->
+        pointer operator->() const {
+            return detail::chunk_data<ValueType>(node) + offset;
+        }
+
+        // Реализация оператора префиксного инкремента
+        ChunkList_iterator &operator++() {
+            if (++offset == node->count) {
+                node = node->next;
+                detail::count_hop(node);
+                offset = 0;
+            }
+            return *this;
+        }
+
+        // Реализация оператора постфиксного инкремента
+        ChunkList_iterator operator++(int) {
+            ChunkList_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        // Реализация оператора префиксного декремента
+        ChunkList_iterator &operator--() {
+            if (offset == 0) {
+                node = node->prev;
+                detail::count_hop(node);
+                offset = node->count;
+            }
+            --offset;
+            return *this;
+        }
+
+        // Реализация оператора постфиксного декремента
+        ChunkList_iterator operator--(int) {
+            ChunkList_iterator temp(*this);
+            --(*this);
+            return temp;
+        }
+
+        // Реализация оператора сложения с числом
+        ChunkList_iterator operator+(const difference_type &n) const {
+            ChunkList_iterator temp(*this);
+            temp += n;
+            return temp;
+        }
+
+        // Реализация оператора сложения числа с итератором
+        friend ChunkList_iterator operator+(const difference_type &n, const ChunkList_iterator &it) {
+            return it + n;
+        }
+
+        // Реализация оператора присваивания сложения с числом
+        ChunkList_iterator &operator+=(const difference_type &n) {
+            detail::chunk_advance(node, offset, n);
+            return *this;
+        }
+
+        // Реализация оператора вычитания из числа
+        ChunkList_iterator operator-(const difference_type &n) const {
+            ChunkList_iterator temp(*this);
+            temp -= n;
+            return temp;
+        }
+
+        // Реализация оператора присваивания вычитания из числа
+        ChunkList_iterator &operator-=(const difference_type &n) {
+            detail::chunk_advance(node, offset, -n);
+            return *this;
+        }
+
+        // Реализация оператора вычитания двух итераторов
+        difference_type operator-(const ChunkList_iterator &other) const {
+            return detail::chunk_distance(other.node, other.offset, node, offset);
+        }
+
+        // Реализация оператора индексации
+        reference operator[](const difference_type &n) const {
+            return *(*this + n);
+        }
+
+        // Реализация оператора <
+        friend bool operator<(const ChunkList_iterator<ValueType> &lhs,
+                              const ChunkList_iterator<ValueType> &rhs) {
+            return detail::chunk_compare(lhs.node, lhs.offset, rhs.node, rhs.offset) < 0;
+        }
+
+        // Реализация оператора <=
+        friend bool operator<=(const ChunkList_iterator<ValueType> &lhs,
+                               const ChunkList_iterator<ValueType> &rhs) {
+            return detail::chunk_compare(lhs.node, lhs.offset, rhs.node, rhs.offset) <= 0;
+        }
+
+        // Реализация оператора >
+        friend bool operator>(const ChunkList_iterator<ValueType> &lhs,
+                              const ChunkList_iterator<ValueType> &rhs) {
+            return detail::chunk_compare(lhs.node, lhs.offset, rhs.node, rhs.offset) > 0;
+        }
+
+        // Реализация оператора >=
+        friend bool operator>=(const ChunkList_iterator<ValueType> &lhs,
+                               const ChunkList_iterator<ValueType> &rhs) {
+            return detail::chunk_compare(lhs.node, lhs.offset, rhs.node, rhs.offset) >= 0;
+        }
+
+        // Реализация оператора <=>
+        friend std::strong_ordering operator<=>(const ChunkList_iterator<ValueType> &lhs,
+                                                const ChunkList_iterator<ValueType> &rhs) {
+            return detail::chunk_compare(lhs.node, lhs.offset, rhs.node, rhs.offset);
+        }
+    };
+
+    template<typename ValueType>
+    class ChunkList_const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = ValueType;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const ValueType *;
+        using reference = const ValueType &;
+    private:
+        detail::chunk_header *node = nullptr;
+        std::size_t offset = 0;
+
+        template<typename, int, typename, typename>
+        friend class ChunkList;
+
+        friend struct detail::segment_access;
+    public:
+        // Реализация конструктора от обычного итератора
+        ChunkList_const_iterator() noexcept = default;
+
+        ChunkList_const_iterator(detail::chunk_header *node, std::size_t offset) noexcept
+                : node(node), offset(offset) {
+        }
+
+        // Реализация конструктора копирования
+        ChunkList_const_iterator(const ChunkList_const_iterator &) noexcept = default;
+
+        // Реализация конструктора от обычного итератора
+        ChunkList_const_iterator(const ChunkList_iterator<ValueType> &other) noexcept
+                : node(other.node), offset(other.offset) {
+        }
+
+        // Реализация оператора присваивания
+        ChunkList_const_iterator &operator=(const ChunkList_const_iterator &) = default;
+
+        // Реализация оператора присваивания от обычного итератора
+        ChunkList_const_iterator &operator=(const ChunkList_iterator<ValueType> &other) {
+            node = other.node;
+            offset = other.offset;
+            return *this;
+        }
+
+        // Реализация деструктора
+        ~ChunkList_const_iterator() = default;
+
+        // Реализация функции swap
+        friend void swap(ChunkList_const_iterator<ValueType> &lhs,
+                         ChunkList_const_iterator<ValueType> &rhs) {
+            std::swap(lhs.node, rhs.node);
+            std::swap(lhs.offset, rhs.offset);
+        }
+
+        // Реализация оператора ==
+        friend bool operator==(const ChunkList_const_iterator<ValueType> &lhs,
+                               const ChunkList_const_iterator<ValueType> &rhs) {
+            return lhs.node == rhs.node && lhs.offset == rhs.offset;
+        }
+
+        // Реализация оператора !=
+        friend bool operator!=(const ChunkList_const_iterator<ValueType> &lhs,
+                               const ChunkList_const_iterator<ValueType> &rhs) {
+            return !(lhs == rhs);
         }
 
         // Реализация оператора разыменования *
         reference operator*() const {
-            return *iterator;
+            return detail::chunk_data<ValueType>(node)[offset];
         }
 
         // Реализация оператора ->
         pointer operator->() const {
-            return *this;
+            return detail::chunk_data<ValueType>(node) + offset;
         }
 
         // Реализация оператора префиксного инкремента
-        ChunkList_iterator &operator++() {
-            iterator += 1;
+        ChunkList_const_iterator &operator++() {
+            if (++offset == node->count) {
+                node = node->next;
+                detail::count_hop(node);
+                offset = 0;
+            }
             return *this;
         }
 
         // Реализация оператора постфиксного инкремента
-        ChunkList_iterator operator++(int) {
-            ChunkList_iterator temp(*this);
+        ChunkList_const_iterator operator++(int) {
+            ChunkList_const_iterator temp(*this);
             ++(*this);
             return temp;
         }
 
         // Реализация оператора префиксного декремента
-        ChunkList_iterator &operator--() {
+        ChunkList_const_iterator &operator--() {
+            if (offset == 0) {
+                node = node->prev;
+                detail::count_hop(node);
+                offset = node->count;
+            }
+            --offset;
             return *this;
         }
 
         // Реализация оператора постфиксного декремента
-        ChunkList_iterator operator--(int) {
-            ChunkList_iterator temp(*this);
+        ChunkList_const_iterator operator--(int) {
+            ChunkList_const_iterator temp(*this);
             --(*this);
             return temp;
         }
 
         // Реализация оператора сложения с числом
-        ChunkList_iterator operator+(const difference_type &n) const {
-            //            ChunkList_iterator temp(*this);
-            //            temp.pointer += n;
-            //            return temp;
+        ChunkList_const_iterator operator+(const difference_type &n) const {
+            ChunkList_const_iterator temp(*this);
+            temp += n;
+            return temp;
+        }
+
+        // Реализация оператора сложения числа с итератором
+        friend ChunkList_const_iterator operator+(const difference_type &n, const ChunkList_const_iterator &it) {
+            return it + n;
         }
 
         // Реализация оператора присваивания сложения с числом
-        ChunkList_iterator &operator+=(const difference_type &) {
+        ChunkList_const_iterator &operator+=(const difference_type &n) {
+            detail::chunk_advance(node, offset, n);
             return *this;
         }
 
         // Реализация оператора вычитания из числа
-        ChunkList_iterator operator-(const difference_type &n) const {
-            //            ChunkList_iterator temp(*this);
-            //            temp.pointer -= n;
-            //            return temp;
+        ChunkList_const_iterator operator-(const difference_type &n) const {
+            ChunkList_const_iterator temp(*this);
+            temp -= n;
+            return temp;
         }
 
         // Реализация оператора присваивания вычитания из числа
-        ChunkList_iterator &operator-=(const difference_type &) {
+        ChunkList_const_iterator &operator-=(const difference_type &n) {
+            detail::chunk_advance(node, offset, -n);
             return *this;
         }
 
         // Реализация оператора вычитания двух итераторов
-        difference_type operator-(const ChunkList_iterator &) const {
-            return *this;
+        difference_type operator-(const ChunkList_const_iterator &other) const {
+            return detail::chunk_distance(other.node, other.offset, node, offset);
         }
 
         // Реализация оператора индексации
-        reference operator[](const difference_type &n) {
+        reference operator[](const difference_type &n) const {
             return *(*this + n);
         }
 
         // Реализация оператора <
-        friend bool operator<(const ChunkList_iterator<ValueType> &lhs,
-                              const ChunkList_iterator<ValueType> &rhs) {
-            return lhs.iterator < rhs.iterator;
+        friend bool operator<(const ChunkList_const_iterator<ValueType> &lhs,
+                              const ChunkList_const_iterator<ValueType> &rhs) {
+            return detail::chunk_compare(lhs.node, lhs.offset, rhs.node, rhs.offset) < 0;
         }
 
         // Реализация оператора <=
-        friend bool operator<=(const ChunkList_iterator<ValueType> &lhs,
-                               const ChunkList_iterator<ValueType> &rhs) {
-            return lhs.iterator <= rhs.iterator;
+        friend bool operator<=(const ChunkList_const_iterator<ValueType> &lhs,
+                               const ChunkList_const_iterator<ValueType> &rhs) {
+            return detail::chunk_compare(lhs.node, lhs.offset, rhs.node, rhs.offset) <= 0;
         }
 
         // Реализация оператора >
-        friend bool operator>(const ChunkList_iterator<ValueType> &lhs,
-                              const ChunkList_iterator<ValueType> &rhs) {
-            return lhs.iterator > rhs.iterator;
+        friend bool operator>(const ChunkList_const_iterator<ValueType> &lhs,
+                              const ChunkList_const_iterator<ValueType> &rhs) {
+            return detail::chunk_compare(lhs.node, lhs.offset, rhs.node, rhs.offset) > 0;
         }
 
         // Реализация оператора >=
-        friend bool operator>=(const ChunkList_iterator<ValueType> &lhs,
-                               const ChunkList_iterator<ValueType> &rhs) {
-            return lhs.iterator >= rhs.iterator;
+        friend bool operator>=(const ChunkList_const_iterator<ValueType> &lhs,
+                               const ChunkList_const_iterator<ValueType> &rhs) {
+            return detail::chunk_compare(lhs.node, lhs.offset, rhs.node, rhs.offset) >= 0;
         }
 
         // Реализация оператора <=>
-        friend bool operator<=>(const ChunkList_iterator<ValueType> &lhs,
-                                const ChunkList_iterator<ValueType> &rhs) {
-            return lhs.iterator <=> rhs.iterator;
+        friend std::strong_ordering operator<=>(const ChunkList_const_iterator<ValueType> &lhs,
+                                                const ChunkList_const_iterator<ValueType> &rhs) {
+            return detail::chunk_compare(lhs.node, lhs.offset, rhs.node, rhs.offset);
         }
     };
 
+    /// @brief Итератор по чанкам ChunkList: чанк представлен непрерывным отрезком std::span
+    /// со своими элементами. Алгоритмы, обходящие список отрезками (сегментированный итератор),
+    /// не проверяют границу чанка на каждом элементе и могут делить работу по чанкам.
     template<typename ValueType>
-    class ChunkList_const_iterator {
+    class ChunkList_chunk_iterator {
     public:
-        using iterator_category = std::random_access_iterator_tag;
-        using value_type = ValueType;
+        using iterator_concept = std::bidirectional_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::span<ValueType>;
         using difference_type = std::ptrdiff_t;
-        using pointer = const ValueType *;
-        using reference = const ValueType &;
+        using reference = std::span<ValueType>;
     private:
-        const value_type *iterator;
+        detail::chunk_header *node = nullptr;
     public:
-        // Реализация конструктора от обычного итератора
-        ChunkList_const_iterator() noexcept = default;
 
-        // Реализация конструктора копирования
-        ChunkList_const_iterator(const ChunkList_const_iterator &) noexcept {
+        // Реализация конструктора по умолчанию
+        ChunkList_chunk_iterator() noexcept = default;
 
+        explicit ChunkList_chunk_iterator(detail::chunk_header *node) noexcept : node(node) {
         }
 
-        // Реализация конструктора от обычного итератора
-        ChunkList_const_iterator(const ChunkList_iterator<ValueType> &) noexcept {
+        // Реализация оператора ==
+        friend bool operator==(const ChunkList_chunk_iterator &lhs, const ChunkList_chunk_iterator &rhs) noexcept {
+            return lhs.node == rhs.node;
+        }
 
+        // Реализация оператора разыменования *: элементы чанка
+        reference operator*() const noexcept {
+            return reference(detail::chunk_data<std::remove_const_t<ValueType>>(node), node->count);
         }
 
-        // Реализация оператора присваивания
-        ChunkList_const_iterator &operator=(const ChunkList_const_iterator &) {
+        // Реализация оператора префиксного инкремента
+        ChunkList_chunk_iterator &operator++() noexcept {
+            node = node->next;
+            detail::count_hop(node);
             return *this;
         }
 
-        // Реализация оператора присваивания от обычного итератора
-        ChunkList_const_iterator &operator=(const ChunkList_iterator<ValueType> &) {
+        // Реализация оператора постфиксного инкремента
+        ChunkList_chunk_iterator operator++(int) noexcept {
+            ChunkList_chunk_iterator old = *this;
+            node = node->next;
+            detail::count_hop(node);
+            return old;
+        }
+
+        // Реализация оператора префиксного декремента
+        ChunkList_chunk_iterator &operator--() noexcept {
+            node = node->prev;
+            detail::count_hop(node);
             return *this;
         }
 
-        // Реализация деструктора
-        ~ChunkList_const_iterator() = default;
+        // Реализация оператора постфиксного декремента
+        ChunkList_chunk_iterator operator--(int) noexcept {
+            ChunkList_chunk_iterator old = *this;
+            node = node->prev;
+            detail::count_hop(node);
+            return old;
+        }
+    };
 
-        // Реализация функции swap
-        friend void swap(ChunkList_const_iterator<ValueType> &lhs,
-                         ChunkList_const_iterator<ValueType> &rhs) {
+    /// @brief Диапазон чанков ChunkList, см. ChunkList::chunks(). Действителен, пока
+    /// существует контейнер; изменения контейнера аннулируют полученные отрезки.
+    template<typename ValueType>
+    class ChunkList_chunk_range {
+    public:
+        using iterator = ChunkList_chunk_iterator<ValueType>;
 
+        explicit ChunkList_chunk_range(detail::chunk_header *sentinel) noexcept : sentinel(sentinel) {
         }
 
-        // Реализация оператора ==
-        friend bool operator==(const ChunkList_const_iterator<ValueType> &lhs,
-                               const ChunkList_const_iterator<ValueType> &rhs) {
-            return lhs.iterator == rhs.iterator;
+        iterator begin() const noexcept {
+            return iterator(sentinel->next);
         }
 
-        // Реализация оператора !=
-        friend bool operator!=(const ChunkList_const_iterator<ValueType> &lhs,
-                               const ChunkList_const_iterator<ValueType> &rhs) {
-            return lhs.iterator != rhs.iterator;
+        iterator end() const noexcept {
+            return iterator(sentinel);
         }
 
-        // Реализация оператора разыменования *
-        reference operator*() const {
-            return *iterator;
+        bool empty() const noexcept {
+            return sentinel->next == sentinel;
         }
 
-        // Реализация оператора ->
-        pointer operator->() const {
+    private:
+        detail::chunk_header *sentinel;
+    };
+
+    /// @tparam N число элементов в чанке; 0 - подобрать по sizeof(T) и Options::chunk_bytes
+    /// @tparam Options набор параметров, см. chunk_list_options
+    template<typename T, int N, typename Allocator = Allocator<T>, typename Options = chunk_list_options>
+    class ChunkList {
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using pointer = typename std::allocator_traits<Allocator>::pointer;
+        using const_pointer = typename std::allocator_traits<Allocator>::const_pointer;
+        using iterator = ChunkList_iterator<value_type>;
+        using const_iterator = ChunkList_const_iterator<value_type>;
+
+        /// @brief Число элементов в чанке: N, либо при N = 0 - наибольшее число элементов,
+        /// при котором чанк вместе с заголовком укладывается в Options::chunk_bytes.
+        static constexpr size_type chunk_size =
+                N == 0 ? detail::auto_chunk_size<T>(Options::chunk_bytes) : static_cast<size_type>(N);
+
+    private:
+        static_assert(N >= 0, "ChunkList: размер чанка N не может быть отрицательным");
+
+        using node_type = detail::chunk_header;
+        using chunk_storage = detail::chunk_storage<T, chunk_size>;
+        using alloc_traits = std::allocator_traits<Allocator>;
+        using chunk_allocator = typename alloc_traits::template rebind_alloc<chunk_storage>;
+        using chunk_alloc_traits = std::allocator_traits<chunk_allocator>;
+        using fill_policy = typename Options::fill_policy;
+
+        struct finger_type {
+            node_type *node = nullptr;
+            size_type base = 0;
+            size_type epoch = 0;    // значение epoch списка, при котором палец был верен
+        };
 
+        // Сколько соседних чанков курсор просматривает от пальца, прежде чем позиция ищется через индекс
+        static constexpr size_type finger_reach = 4;
+
+        // Страж кольцевой цепочки чанков: sentinel.next - первый чанк, sentinel.prev - последний
+        node_type sentinel{&sentinel, &sentinel, 0};
+        size_type length = 0;
+        size_type chunk_count = 0;
+        Allocator alloc;
+        detail::chunk_index<Allocator> index;
+        // Счётчик изменений цепочки: растёт при каждом изменении числа элементов чанка и при
+        // появлении, исчезновении или переносе чанка. По нему курсор узнаёт, что палец устарел.
+        size_type epoch = 0;
+        // Статистика обновляется и в константных методах (поиск позиции), поэтому mutable
+        [[no_unique_address]] mutable typename Options::stats counters;
+        [[no_unique_address]] detail::inline_chunk<chunk_storage, Options::inline_first_chunk> embedded;
+
+        // Указатель на массив элементов чанка
+        static T *data(node_type *node) noexcept {
+            return detail::chunk_data<T>(node);
         }
 
-        // Реализация оператора префиксного инкремента
-        ChunkList_const_iterator &operator++() {
-            iterator += 1;
-            return *this;
+        node_type *end_node() const noexcept {
+            return const_cast<node_type *>(&sentinel);
         }
 
-        // Реализация оператора постфиксного инкремента
-        ChunkList_const_iterator operator++(int) {
-            ChunkList_const_iterator temp(*this);
-            ++(*this);
-            return temp;
+        // Учитывает в статистике count перемещений элементов
+        void note_shifts(size_type count) const noexcept {
+            if constexpr (Options::stats::enabled) {
+                counters.element_shifts += count;
+            }
         }
 
-        // Реализация оператора префиксного декремента
-        ChunkList_const_iterator &operator--() {
-            return *this;
+        // Учитывает в статистике count переходов между чанками
+        void note_hops(size_type count) const noexcept {
+            if constexpr (Options::stats::enabled) {
+                counters.chunk_hops += count;
+            }
         }
 
-        // Реализация оператора постфиксного декремента
-        ChunkList_const_iterator operator--(int) {
-            ChunkList_const_iterator temp(*this);
-            --(*this);
-            return temp;
+        // Учитывает изменение числа элементов чанка node на delta в индексе позиций и в epoch
+        void count_changed(node_type *node, difference_type delta) noexcept {
+            index.add(node, delta);
+            ++epoch;
         }
 
-        // Реализация оператора сложения с числом
-        ChunkList_const_iterator operator+(const difference_type &) const {
-            return *this;
+        // Ищет чанк с элементом pos, начиная с пальца f и проходя не больше finger_reach соседних
+        // чанков. При успехе палец переезжает на найденный чанк. Палец, заведённый до изменения
+        // цепочки, не используется: его чанк мог сместиться или быть освобождён.
+        bool seek_near(finger_type &f, size_type pos) const noexcept {
+            node_type *node = f.node;
+            size_type base = f.base;
+            if (node == nullptr || f.epoch != epoch || pos >= length) {
+                return false;
+            }
+            for (size_type step = 0;; ++step) {
+                if (pos < base) {
+                    if (step == finger_reach) {
+                        return false;
+                    }
+                    node = node->prev;
+                    base -= node->count;
+                    note_hops(1);
+                } else if (pos - base >= node->count) {
+                    if (step == finger_reach) {
+                        return false;
+                    }
+                    base += node->count;
+                    node = node->next;
+                    note_hops(1);
+                } else {
+                    f = {node, base, epoch};
+                    return true;
+                }
+            }
         }
 
-        // Реализация оператора присваивания сложения с числом
-        ChunkList_const_iterator &operator+=(const difference_type &) {
-            return *this;
+        // Итератор на позицию offset в чанке node. Позиция за последним элементом чанка
+        // переносится на начало следующего чанка, чтобы у каждого элемента было одно представление.
+        iterator make_iterator(node_type *node, size_type offset) const noexcept {
+            if (node != end_node() && offset == node->count) {
+                return iterator(node->next, 0);
+            }
+            return iterator(node, offset);
         }
 
-        // Реализация оператора вычитания из числа
-        ChunkList_const_iterator operator-(const difference_type &) const {
-            return *this;
+        // Выделяет пустой чанк и вставляет его в цепочку перед pos
+        node_type *create_chunk(node_type *pos) {
+            chunk_storage *storage;
+            if constexpr (Options::inline_first_chunk) {
+                if (!embedded.used) {
+                    embedded.used = true;
+                    storage = &embedded.storage;
+                } else {
+                    chunk_allocator chunk_alloc(alloc);
+                    storage = chunk_alloc_traits::allocate(chunk_alloc, 1);
+                }
+            } else {
+                chunk_allocator chunk_alloc(alloc);
+                storage = chunk_alloc_traits::allocate(chunk_alloc, 1);
+            }
+            auto *node = ::new(static_cast<void *>(storage)) node_type{pos->prev, pos, 0};
+            pos->prev->next = node;
+            pos->prev = node;
+            ++chunk_count;
+            ++epoch;
+            if constexpr (Options::stats::enabled) {
+                ++counters.chunk_allocations;
+                node->hops = &counters.chunk_hops;
+            }
+            if (index.active()) {
+                index.insert(alloc, node, node->prev != &sentinel ? node->prev : nullptr);
+            } else if (chunk_count > 2) {
+                index.rebuild(alloc, &sentinel);
+            }
+            return node;
+        }
+
+        // Отцепляет пустой чанк от цепочки и возвращает его память аллокатору
+        void release_chunk(node_type *node) noexcept {
+            index.erase(alloc, node);
+            node->prev->next = node->next;
+            node->next->prev = node->prev;
+            if (--chunk_count == 0) {
+                index.reset(alloc);
+            }
+            ++epoch;
+            if constexpr (Options::stats::enabled) {
+                ++counters.chunk_frees;
+            }
+            if constexpr (Options::inline_first_chunk) {
+                if (embedded.owns(node)) {
+                    embedded.used = false;
+                    return;
+                }
+            }
+            chunk_allocator chunk_alloc(alloc);
+            chunk_alloc_traits::deallocate(chunk_alloc, reinterpret_cast<chunk_storage *>(node), 1);
+        }
+
+        // Строит индекс позиций заново после перецепления многих чанков. Списку из одного или
+        // двух чанков индекс не нужен: его элементы находятся от краёв цепочки.
+        void reindex() noexcept {
+            if (chunk_count > 2) {
+                index.rebuild(alloc, &sentinel);
+            } else {
+                index.reset(alloc);
+            }
+        }
+
+        // Направляет переходы обхода по чанкам [head, stop) в счётчики этого списка. Без
+        // статистики ничего не делает, поэтому перенос цепочки остаётся O(1).
+        void claim_chunks(node_type *head, node_type *stop) noexcept {
+            if constexpr (Options::stats::enabled) {
+                for (node_type *node = head; node != stop; node = node->next) {
+                    node->hops = &counters.chunk_hops;
+                }
+            }
+        }
+
+        // Забирает цепочку чанков other, перецепляя её на собственного стража; this должен быть
+        // пуст. Встроенный чанк other не может сменить владельца, поэтому его элементы
+        // перемещаются во встроенный чанк this (итераторы на них становятся недействительными).
+        void take_chain(ChunkList &other) noexcept(!Options::inline_first_chunk ||
+                                                   std::is_nothrow_move_constructible_v<T>) {
+            if (other.length == 0) {
+                return;
+            }
+            if constexpr (Options::inline_first_chunk) {
+                if (other.embedded.used) {
+                    auto *from = reinterpret_cast<node_type *>(&other.embedded.storage);
+                    auto *to = ::new(static_cast<void *>(&embedded.storage))
+                            node_type{from->prev, from->next, from->count, from->head};
+                    std::uninitialized_move(data(from), data(from) + from->count, data(to));
+                    std::destroy(data(from), data(from) + from->count);
+                    note_shifts(from->count);
+                    to->prev->next = to;
+                    to->next->prev = to;
+                    other.index.replace(from, to);
+                    embedded.used = true;
+                    other.embedded.used = false;
+                }
+            }
+            sentinel.next = other.sentinel.next;
+            sentinel.prev = other.sentinel.prev;
+            sentinel.next->prev = &sentinel;
+            sentinel.prev->next = &sentinel;
+            length = other.length;
+            chunk_count = other.chunk_count;
+            other.sentinel.next = other.sentinel.prev = &other.sentinel;
+            other.length = other.chunk_count = 0;
+            // Индекс ссылается на те же чанки и уходит вместе с цепочкой; аллокаторы равны
+            index.take(other.index);
+            claim_chunks(sentinel.next, &sentinel);
+            ++epoch;
+            ++other.epoch;
+        }
+
+        // Переносит элементы [from, count) чанка node в новый чанк, вставленный следом за ним.
+        // При to_back элементы ложатся в конец массива нового чанка, оставляя место перед ними.
+        node_type *split_chunk(node_type *node, size_type from, bool to_back = false) {
+            node_type *tail = create_chunk(node->next);
+            T *source = data(node);
+            if (to_back) {
+                tail->head = chunk_size - (node->count - from);
+            }
+            try {
+                std::uninitialized_move(source + from, source + node->count, data(tail));
+            } catch (...) {
+                release_chunk(tail);
+                throw;
+            }
+            std::destroy(source + from, source + node->count);
+            note_shifts(node->count - from);
+            tail->count = node->count - from;
+            node->count = from;
+            count_changed(node, -static_cast<difference_type>(tail->count));
+            count_changed(tail, static_cast<difference_type>(tail->count));
+            return tail;
+        }
+
+        // Число свободных ячеек после последнего элемента чанка
+        static size_type back_room(const node_type *node) noexcept {
+            return chunk_size - node->head - node->count;
+        }
+
+        // Сдвигает элементы чанка node в начало его массива: всё свободное место оказывается
+        // после них
+        void pack_chunk(node_type *node) {
+            size_type head = node->head;
+            size_type count = node->count;
+            if (head == 0) {
+                return;
+            }
+            T *from = data(node);
+            T *to = from - head;
+            // Ячейки перед элементами ещё не заняты, остальные переписываются присваиванием
+            size_type fresh = std::min(head, count);
+            std::uninitialized_move(from, from + fresh, to);
+            std::move(from + fresh, from + count, to + fresh);
+            std::destroy(to + std::max(head, count), from + count);
+            note_shifts(count);
+            node->head = 0;
+        }
+
+        // Дописывает элемент в конец чанка node; если места нет (или node - страж),
+        // элемент уходит в новый чанк, вставленный следом. Возвращает чанк с элементом.
+        template<class... Args>
+        node_type *append_to(node_type *node, Args &&... args) {
+            if (node == &sentinel || node->count == chunk_size) {
+                node = create_chunk(node->next);
+            } else if (back_room(node) == 0) {
+                // Свободно только место перед элементами. Сдвиг окупается, если освобождает
+                // не меньше половины сдвигаемых элементов, иначе элемент уходит в новый чанк.
+                if (2 * node->head >= node->count) {
+                    // Аргументы могут ссылаться на элементы этого чанка: значение строится
+                    // до сдвига, который перемещает и разрушает прежние ячейки
+                    T value(std::forward<Args>(args)...);
+                    pack_chunk(node);
+                    return append_to(node, std::move(value));
+                } else {
+                    node = create_chunk(node->next);
+                }
+            }
+            try {
+                alloc_traits::construct(alloc, data(node) + node->count, std::forward<Args>(args)...);
+            } catch (...) {
+                if (node->count == 0) {
+                    release_chunk(node);
+                }
+                throw;
+            }
+            ++node->count;
+            ++length;
+            count_changed(node, 1);
+            return node;
+        }
+
+        // Строит элемент в ячейке перед первым элементом чанка node; если там нет места (или
+        // node - страж), элемент занимает последнюю ячейку нового чанка, вставленного перед node.
+        // Элементы чанков не сдвигаются. Возвращает чанк с элементом.
+        template<class... Args>
+        node_type *prepend_to(node_type *node, Args &&... args) {
+            if (node == &sentinel || node->head == 0) {
+                node = create_chunk(node);
+                node->head = chunk_size;
+            }
+            try {
+                alloc_traits::construct(alloc, data(node) - 1, std::forward<Args>(args)...);
+            } catch (...) {
+                if (node->count == 0) {
+                    release_chunk(node);
+                }
+                throw;
+            }
+            --node->head;
+            ++node->count;
+            ++length;
+            count_changed(node, 1);
+            return node;
+        }
+
+        // Вставляет элемент перед позицией offset чанка node (страж означает вставку в конец).
+        // Сначала пробует место в существующих чанках, заполненный чанк делится пополам.
+        template<class... Args>
+        iterator emplace_at(node_type *node, size_type offset, Args &&... args) {
+            if (offset == 0) {
+                // Стык чанков: дописываем в конец предыдущего чанка, не сдвигая элементы
+                node_type *prev = node->prev;
+                if (node == &sentinel || (prev != &sentinel && prev->count < chunk_size)) {
+                    prev = append_to(prev, std::forward<Args>(args)...);
+                    return iterator(prev, prev->count - 1);
+                }
+            }
+            if constexpr (sizeof...(Args) == 1 && (std::is_same_v<Args, T> && ...)) {
+                // Rvalue того же типа перемещается на место без промежуточного объекта
+                return insert_into_chunk(node, offset, std::move(args)...);
+            } else {
+                // Значение строится до деления и сдвига: аргументы могут ссылаться на элементы чанка
+                T value(std::forward<Args>(args)...);
+                return insert_into_chunk(node, offset, std::move(value));
+            }
+        }
+
+        // Вставляет value перед позицией offset чанка node; вставка в заполненный чанк
+        // выполняется по политике fill_policy
+        iterator insert_into_chunk(node_type *node, size_type offset, T &&value) {
+            if (node->count == chunk_size) {
+                if constexpr (Options::gap_chunks) {
+                    return insert_into_full(node, offset, std::move(value), gap_split());
+                } else {
+                    return insert_into_full(node, offset, std::move(value), fill_policy());
+                }
+            }
+            return insert_with_room(node, offset, std::move(value));
+        }
+
+        // Вставляет value перед позицией offset чанка node, в котором есть свободное место.
+        // Сдвигается меньшая часть чанка, если место есть с обеих сторон: начало влево, в
+        // место перед элементами, или хвост вправо.
+        iterator insert_with_room(node_type *node, size_type offset, T &&value) {
+            T *first = data(node);
+            size_type count = node->count;
+            if (node->head != 0 && (back_room(node) == 0 || offset < count - offset)) {
+                if (offset == 0) {
+                    alloc_traits::construct(alloc, first - 1, std::move(value));
+                } else {
+                    alloc_traits::construct(alloc, first - 1, std::move(first[0]));
+                    std::move(first + 1, first + offset, first);
+                    first[offset - 1] = std::move(value);
+                }
+                note_shifts(offset);
+                --node->head;
+            } else if (offset == count) {
+                alloc_traits::construct(alloc, first + count, std::move(value));
+            } else {
+                alloc_traits::construct(alloc, first + count, std::move(first[count - 1]));
+                std::move_backward(first + offset, first + count - 1, first + count);
+                first[offset] = std::move(value);
+                note_shifts(count - offset);
+            }
+            ++node->count;
+            ++length;
+            count_changed(node, 1);
+            return iterator(node, offset);
+        }
+
+        // split_fill: верхняя половина чанка уходит в новый чанк
+        iterator insert_into_full(node_type *node, size_type offset, T &&value, split_fill) {
+            size_type half = node->count / 2;
+            node_type *tail = split_chunk(node, half);
+            if (offset > half) {
+                return insert_with_room(tail, offset - half, std::move(value));
+            }
+            return insert_with_room(node, offset, std::move(value));
+        }
+
+        // fresh_fill: хвост после позиции вставки уходит в новый чанк, значение дописывается в конец
+        iterator insert_into_full(node_type *node, size_type offset, T &&value, fresh_fill) {
+            if (offset == 0) {
+                return insert_with_room(create_chunk(node), 0, std::move(value));
+            }
+            split_chunk(node, offset);
+            return insert_with_room(node, offset, std::move(value));
+        }
+
+        // Чанки с зазором: чанк делится в точке вставки, хвост уходит в конец нового чанка,
+        // значение дописывается в конец node. Вставка в начало чанка открывает новый чанк
+        // перед ним, и значение занимает последнюю ячейку: место перед ним примет следующие
+        // вставки в начало.
+        struct gap_split {};
+
+        iterator insert_into_full(node_type *node, size_type offset, T &&value, gap_split) {
+            if (offset == 0) {
+                node_type *front = create_chunk(node);
+                front->head = chunk_size - 1;
+                return insert_with_room(front, 0, std::move(value));
+            }
+            if (offset < node->count) {
+                split_chunk(node, offset, true);
+            }
+            return insert_with_room(node, offset, std::move(value));
+        }
+
+        // spill_fill: крайний элемент переезжает к соседу со свободным местом
+        iterator insert_into_full(node_type *node, size_type offset, T &&value, spill_fill) {
+            node_type *prev = node->prev;
+            node_type *next = node->next;
+            bool to_prev = offset != 0 && prev != &sentinel && back_room(prev) != 0;
+            bool to_next = next != &sentinel && next->count < chunk_size;
+            // Сдвиг к предыдущему чанку стоит offset перемещений, к следующему - хвост этого
+            // чанка и все элементы следующего
+            if (to_prev && to_next && offset > chunk_size - offset + next->count) {
+                to_prev = false;
+            }
+            if (to_prev) {
+                T *first = data(node);
+                alloc_traits::construct(alloc, data(prev) + prev->count, std::move(first[0]));
+                ++prev->count;
+                count_changed(prev, 1);
+                std::move(first + 1, first + offset, first);
+                first[offset - 1] = std::move(value);
+                note_shifts(offset);
+                ++length;
+                return iterator(node, offset - 1);
+            }
+            if (to_next) {
+                T *last = data(node) + node->count - 1;
+                insert_with_room(next, 0, std::move(*last));
+                alloc_traits::destroy(alloc, last);
+                note_shifts(1);
+                --node->count;
+                --length;
+                count_changed(node, -1);
+                return insert_with_room(node, offset, std::move(value));
+            }
+            return insert_into_full(node, offset, std::move(value), split_fill());
+        }
+
+        // Удаляет элемент offset из чанка node, сдвигая хвост чанка влево (у чанков с зазором -
+        // меньшую часть чанка). Первый элемент удаляется без сдвига: его ячейка становится
+        // местом перед элементами. Опустевший чанк освобождается.
+        iterator erase_at(node_type *node, size_type offset) {
+            T *first = data(node);
+            if (Options::gap_chunks ? offset < node->count - 1 - offset : offset == 0) {
+                std::move_backward(first, first + offset, first + offset + 1);
+                alloc_traits::destroy(alloc, first);
+                ++node->head;
+                note_shifts(offset);
+            } else {
+                std::move(first + offset + 1, first + node->count, first + offset);
+                alloc_traits::destroy(alloc, first + node->count - 1);
+                note_shifts(node->count - 1 - offset);
+            }
+            --node->count;
+            --length;
+            count_changed(node, -1);
+            if (node->count == 0) {
+                node_type *next = node->next;
+                release_chunk(node);
+                return iterator(next, 0);
+            }
+            return make_iterator(node, offset);
+        }
+
+        // Удаляет элементы [from, to) чанка node, сдвигая хвост чанка влево (у чанков с
+        // зазором - меньшую часть чанка). Опустевший чанк освобождается.
+        iterator erase_span(node_type *node, size_type from, size_type to) {
+            T *first = data(node);
+            size_type removed = to - from;
+            if (Options::gap_chunks && from < node->count - to) {
+                std::move_backward(first, first + from, first + to);
+                std::destroy(first, first + removed);
+                node->head += removed;
+                note_shifts(from);
+            } else {
+                std::move(first + to, first + node->count, first + from);
+                std::destroy(first + node->count - removed, first + node->count);
+                note_shifts(node->count - to);
+            }
+            node->count -= removed;
+            length -= removed;
+            count_changed(node, -static_cast<difference_type>(removed));
+            if (node->count == 0) {
+                node_type *next = node->next;
+                release_chunk(node);
+                return iterator(next, 0);
+            }
+            return make_iterator(node, from);
+        }
+
+        // Удаляет элементы, для которых pred возвращает true. Сжатие идёт внутри каждого чанка:
+        // find_first(begin, end) быстро находит первое совпадение, после него оставшиеся
+        // элементы сдвигаются к началу чанка. pred вызывается ровно один раз для каждого
+        // элемента после первого совпадения. Опустевшие чанки освобождаются.
+        template<class FindFirst, class Predicate>
+        size_type remove_matching(FindFirst find_first, Predicate pred) {
+            size_type removed = 0;
+            node_type *node = sentinel.next;
+            while (node != &sentinel) {
+                node_type *next = node->next;
+                T *first = data(node);
+                T *last = first + node->count;
+                T *out = find_first(first, last);
+                if (out != last) {
+                    T *hit = out;
+                    for (T *p = out + 1; p != last; ++p) {
+                        if (!pred(*p)) {
+                            *out = std::move(*p);
+                            ++out;
+                        }
+                    }
+                    note_shifts(static_cast<size_type>(out - hit));
+                    auto erased = static_cast<size_type>(last - out);
+                    std::destroy(out, last);
+                    node->count -= erased;
+                    length -= erased;
+                    removed += erased;
+                    count_changed(node, -static_cast<difference_type>(erased));
+                    if (node->count == 0) {
+                        release_chunk(node);
+                    }
+                }
+                node = next;
+            }
+            return removed;
+        }
+
+        // Готовит групповую вставку перед позицией offset чанка node: хвост чанка после позиции
+        // уносится в отдельный чанк, и новые элементы дописываются в конец возвращаемого чанка
+        // цепочкой полных чанков.
+        node_type *open_insert_point(node_type *node, size_type offset) {
+            if (offset == 0) {
+                return node->prev;
+            }
+            if (offset < node->count) {
+                split_chunk(node, offset);
+            }
+            return node;
+        }
+
+        // Вставляет элементы [first, last) перед позицией offset чанка node
+        template<class InputIt>
+        iterator insert_range_at(node_type *node, size_type offset, InputIt first, InputIt last) {
+            if (first == last) {
+                return iterator(node, offset);
+            }
+            node_type *head = append_to(open_insert_point(node, offset), *first);
+            size_type head_offset = head->count - 1;
+            node = head;
+            for (++first; first != last; ++first) {
+                node = append_to(node, *first);
+            }
+            return iterator(head, head_offset);
+        }
+
+        // Итератор на элемент с номером pos. Поиск только читает контейнер, поэтому
+        // одновременные operator[] и at() из разных потоков безопасны.
+        iterator locate(size_type pos) {
+            const_iterator it = std::as_const(*this).locate(pos);
+            return iterator(it.node, it.offset);
+        }
+
+        // Первый и последний чанки находятся без индекса (короткому списку индекс не нужен),
+        // остальные - спуском по индексу позиций. Если на индекс не хватило памяти, цепочка
+        // обходится от ближайшего к pos конца.
+        const_iterator locate(size_type pos) const {
+            if (pos < sentinel.next->count) {
+                return const_iterator(sentinel.next, pos);
+            }
+            if (length - pos <= sentinel.prev->count) {
+                return const_iterator(sentinel.prev, sentinel.prev->count - (length - pos));
+            }
+            if (index.active()) {
+                auto [node, offset] = index.find(pos);
+                return const_iterator(node, offset);
+            }
+            if (pos < length / 2) {
+                return begin() + static_cast<difference_type>(pos);
+            }
+            return end() - static_cast<difference_type>(length - pos);
+        }
+
+        // Номер элемента, на который указывает it: через индекс за O(log C), без индекса -
+        // проходом от начала цепочки
+        size_type position_of(const_iterator it) const noexcept {
+            if (it.node == end_node()) {
+                return length;
+            }
+            if (index.active()) {
+                return index.rank(it.node) + it.offset;
+            }
+            return static_cast<size_type>(it - cbegin());
+        }
+
+        // Указатель на элемент pos для курсора с пальцем f: элемент ищется от пальца, иначе
+        // через locate, и палец переезжает на его чанк
+        T *seek(finger_type &f, size_type pos) {
+            if (!seek_near(f, pos)) {
+                iterator it = locate(pos);
+                f = {it.node, pos - it.offset, epoch};
+            }
+            return data(f.node) + (pos - f.base);
+        }
+
+        const T *seek(finger_type &f, size_type pos) const {
+            if (!seek_near(f, pos)) {
+                const_iterator it = locate(pos);
+                f = {it.node, pos - it.offset, epoch};
+            }
+            return data(f.node) + (pos - f.base);
+        }
+
+        // Переносит первые count элементов чанка src в конец чанка dst (в нём должно хватать места).
+        // Оставшиеся элементы src не сдвигаются: освободившиеся ячейки становятся местом перед ними.
+        void move_front(node_type *src, size_type count, node_type *dst) {
+            if (back_room(dst) < count) {
+                pack_chunk(dst);
+            }
+            T *from = data(src);
+            std::uninitialized_move(from, from + count, data(dst) + dst->count);
+            note_shifts(count);
+            dst->count += count;
+            count_changed(dst, static_cast<difference_type>(count));
+            std::destroy(from, from + count);
+            src->head += count;
+            src->count -= count;
+            count_changed(src, -static_cast<difference_type>(count));
         }
 
-        // Реализация оператора присваивания вычитания из числа
-        ChunkList_const_iterator &operator-=(const difference_type &) {
-            return *this;
+        // Сливает чанк node со следующим, если их элементы помещаются в один чанк
+        void merge_with_next(node_type *node) {
+            node_type *next = node->next;
+            if (node == &sentinel || next == &sentinel || node->count + next->count > chunk_size) {
+                return;
+            }
+            move_front(next, next->count, node);
+            release_chunk(next);
         }
 
-        // Реализация оператора вычитания двух итераторов
-        difference_type operator-(const ChunkList_const_iterator &) const {
-            return *this;
+        // Переносит элементы встроенного чанка node в чанк из аллокатора, занимающий его место
+        // в цепочке. Нужно перед передачей чанка другому списку.
+        node_type *relocate_embedded(node_type *node) {
+            chunk_allocator chunk_alloc(alloc);
+            chunk_storage *storage = chunk_alloc_traits::allocate(chunk_alloc, 1);
+            auto *moved = ::new(static_cast<void *>(storage))
+                    node_type{node->prev, node->next, node->count, node->head};
+            try {
+                std::uninitialized_move(data(node), data(node) + node->count, data(moved));
+            } catch (...) {
+                chunk_alloc_traits::deallocate(chunk_alloc, storage, 1);
+                throw;
+            }
+            std::destroy(data(node), data(node) + node->count);
+            note_shifts(node->count);
+            moved->hops = node->hops;
+            moved->prev->next = moved;
+            moved->next->prev = moved;
+            if constexpr (Options::inline_first_chunk) {
+                embedded.used = false;
+            }
+            index.replace(node, moved);
+            ++epoch;
+            return moved;
         }
 
-        // Реализация оператора индексации
-        reference operator[](const difference_type &) {
-            return *this;
+        // Начало чанка, перед которым встанут пересаживаемые чанки: чанк с позицией offset
+        // делится, если позиция не в его начале
+        node_type *splice_point(node_type *node, size_type offset) {
+            if (offset == 0) {
+                return node;
+            }
+            return split_chunk(node, offset);
         }
 
-        // Реализация оператора <
-        friend bool operator<(const ChunkList_const_iterator<ValueType> &lhs,
-                              const ChunkList_const_iterator<ValueType> &rhs) {
-            return lhs.iterator < rhs.iterator;
+        // Отцепляет чанки с элементами [first, last), деля граничные чанки. Возвращает первый
+        // и последний отцепленные чанки, elements и chunks получают их размеры.
+        std::pair<node_type *, node_type *> detach_chunks(const_iterator first, const_iterator last,
+                                                          size_type &elements, size_type &chunks) {
+            node_type *after = last.offset != 0 ? split_chunk(last.node, last.offset) : last.node;
+            node_type *head = first.offset != 0 ? split_chunk(first.node, first.offset) : first.node;
+            elements = 0;
+            chunks = 0;
+            for (node_type *node = head; node != after; node = node->next) {
+                if (embedded_owns(node)) {
+                    node = relocate_embedded(node);
+                    head = chunks == 0 ? node : head;
+                }
+                elements += node->count;
+                ++chunks;
+            }
+            // Немногие чанки убираются из индекса по одному, многие - перестройкой индекса
+            bool rebuild = 4 * chunks >= chunk_count;
+            if (!rebuild) {
+                for (node_type *node = head; node != after; node = node->next) {
+                    index.erase(alloc, node);
+                }
+            }
+            node_type *tail = after->prev;
+            head->prev->next = after;
+            after->prev = head->prev;
+            length -= elements;
+            chunk_count -= chunks;
+            ++epoch;
+            if (rebuild) {
+                reindex();
+            }
+            merge_with_next(after->prev);
+            return {head, tail};
         }
 
-        // Реализация оператора <=
-        friend bool operator<=(const ChunkList_const_iterator<ValueType> &lhs,
-                               const ChunkList_const_iterator<ValueType> &rhs) {
-            return lhs.iterator <= rhs.iterator;
+        // Вставляет цепочку чанков [head, tail] перед чанком pos и сливает стыки,
+        // если соседние чанки умещаются в один
+        void link_chunks(node_type *pos, node_type *head, node_type *tail, size_type elements, size_type chunks) {
+            node_type *before = pos->prev;
+            before->next = head;
+            head->prev = before;
+            tail->next = pos;
+            pos->prev = tail;
+            length += elements;
+            chunk_count += chunks;
+            claim_chunks(head, pos);
+            ++epoch;
+            if (index.active() && 4 * chunks < chunk_count) {
+                for (node_type *node = head; node != pos; node = node->next) {
+                    index.insert(alloc, node, node->prev != &sentinel ? node->prev : nullptr);
+                }
+            } else {
+                reindex();
+            }
+            merge_with_next(tail);
+            merge_with_next(before);
         }
 
-        // Реализация оператора >
-        friend bool operator>(const ChunkList_const_iterator<ValueType> &lhs,
-                              const ChunkList_const_iterator<ValueType> &rhs) {
-            return lhs.iterator > rhs.iterator;
+        // Переставляет элементы [first, last) этого контейнера перед pos. Отцепление диапазона
+        // делит и сливает граничные чанки, поэтому pos запоминается номером элемента и
+        // находится заново после отцепления.
+        void move_range(const_iterator pos, const_iterator first, const_iterator last) {
+            size_type at = position_of(pos);
+            size_type from = position_of(first);
+            size_type to = position_of(last);
+            if (at > from && at < to) {
+                throw std::invalid_argument("ChunkList::splice(): pos is inside [first, last)");
+            }
+            if (at == from || at == to) {
+                return;
+            }
+            ChunkList range(alloc);
+            range.splice(range.cend(), *this, first, last);
+            size_type target = at < from ? at : at - (to - from);
+            splice(target == length ? cend() : std::as_const(*this).locate(target), range);
         }
 
-        // Реализация оператора >=
-        friend bool operator>=(const ChunkList_const_iterator<ValueType> &lhs,
-                               const ChunkList_const_iterator<ValueType> &rhs) {
-            return lhs.iterator >= rhs.iterator;
+        bool embedded_owns(const node_type *node) const noexcept {
+            if constexpr (Options::inline_first_chunk) {
+                return embedded.used && embedded.owns(node);
+            } else {
+                return false;
+            }
         }
 
-        // Реализация оператора <=>
-        friend bool operator<=>(const ChunkList_const_iterator<ValueType> &lhs,
-                                const ChunkList_const_iterator<ValueType> &rhs) {
-            return lhs.iterator <=> rhs.iterator;
+        // Заполняет пустой контейнер элементами [first, last); при исключении освобождает всё выделенное
+        template<class InputIt>
+        void init_range(InputIt first, InputIt last) {
+            try {
+                if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                        typename std::iterator_traits<InputIt>::iterator_category>) {
+                    fill_chunks(first, static_cast<size_type>(std::distance(first, last)));
+                } else {
+                    node_type *node = sentinel.prev;
+                    for (; first != last; ++first) {
+                        node = append_to(node, *first);
+                    }
+                }
+            } catch (...) {
+                clear();
+                throw;
+            }
         }
-    };
 
-    template<typename T, int N, typename Allocator = Allocator<T>>
-    class ChunkList {
-    public:
-        using value_type = T;
-        using allocator_type = Allocator;
-        using size_type = std::size_t;
-        using difference_type = std::ptrdiff_t;
-        using reference = value_type &;
-        using const_reference = const value_type &;
-        using pointer = typename std::allocator_traits<Allocator>::pointer;
-        using const_pointer = typename std::allocator_traits<Allocator>::const_pointer;
-        using iterator = ChunkList_iterator<value_type>;
-        using const_iterator = ChunkList_const_iterator<value_type>;
+        // Дописывает count элементов прямого диапазона полными чанками. Размер диапазона известен
+        // заранее, поэтому каждый чанк заполняется одним std::uninitialized_copy, который для
+        // тривиально копируемых T сводится к memmove.
+        template<class ForwardIt>
+        void fill_chunks(ForwardIt first, size_type count) {
+            while (count != 0) {
+                size_type taken = std::min<size_type>(count, chunk_size);
+                ForwardIt next = std::next(first, static_cast<difference_type>(taken));
+                node_type *node = create_chunk(&sentinel);
+                try {
+                    std::uninitialized_copy(first, next, data(node));
+                } catch (...) {
+                    release_chunk(node);
+                    throw;
+                }
+                node->count = taken;
+                length += taken;
+                count_changed(node, static_cast<difference_type>(taken));
+                first = next;
+                count -= taken;
+            }
+        }
 
-    private:
-        iterator it = ChunkList_iterator<int>();
-        pointer p;
-        Allocator alloc;
+        // Заполняет пустой контейнер копиями элементов other, упакованными в полные чанки:
+        // выделяется ровно ceil(size / N) чанков. Элементы копируются отрезками, общими для
+        // чанка-источника и чанка-приёмника; для тривиально копируемых T каждый отрезок - один
+        // memcpy, так что у плотного источника на чанк приходится одно копирование.
+        void copy_chunks(const ChunkList &other) {
+            node_type *tail = &sentinel;
+            try {
+                for (node_type *src = other.sentinel.next; src != &other.sentinel; src = src->next) {
+                    const T *from = data(src);
+                    size_type left = src->count;
+                    while (left != 0) {
+                        if (tail == &sentinel || tail->count == chunk_size) {
+                            tail = create_chunk(&sentinel);
+                        }
+                        size_type taken = std::min(left, chunk_size - tail->count);
+                        if constexpr (std::is_trivially_copyable_v<T>) {
+                            std::memcpy(static_cast<void *>(data(tail) + tail->count), from, taken * sizeof(T));
+                        } else {
+                            std::uninitialized_copy(from, from + taken, data(tail) + tail->count);
+                        }
+                        tail->count += taken;
+                        length += taken;
+                        count_changed(tail, static_cast<difference_type>(taken));
+                        from += taken;
+                        left -= taken;
+                    }
+                }
+            } catch (...) {
+                clear();
+                throw;
+            }
+        }
 
+        // Заполняет пустой контейнер count элементами, сконструированными из args
+        template<class... Args>
+        void init_fill(size_type count, const Args &... args) {
+            try {
+                node_type *node = sentinel.prev;
+                for (size_type i = 0; i < count; ++i) {
+                    node = append_to(node, args...);
+                }
+            } catch (...) {
+                clear();
+                throw;
+            }
+        }
 
     public:
         /// @brief Конструктор по умолчанию. Создает пустой контейнер с
@@ -397,8 +2859,7 @@ namespace fefu_laboratory_two {
         /// @brief Создает пустой контейнер с заданным аллокатором
         /// @param alloc аллокатор, который будет использоваться для всех выделений памяти этого контейнера
         // Конструктор с аллокатором
-        explicit ChunkList(const Allocator &alloc) {
-
+        explicit ChunkList(const Allocator &alloc) : alloc(alloc) {
         }
 
         /// @brief Конструирует контейнер с count-копиями элементов со значением
@@ -407,8 +2868,8 @@ namespace fefu_laboratory_two {
         /// @param value значение, которым инициализируются элементы контейнера
         /// @param alloc аллокатор, который будет использоваться для всех выделений памяти этого контейнера
         // Конструктор с count копиями элементов со значением и аллокатором
-        ChunkList(size_type count, const T &value, const Allocator &alloc = Allocator()) {
-
+        ChunkList(size_type count, const T &value, const Allocator &alloc = Allocator()) : alloc(alloc) {
+            init_fill(count, value);
         }
 
         /// @brief Конструирует контейнер с подсчетом вставленных по умолчанию экземпляров
@@ -416,8 +2877,8 @@ namespace fefu_laboratory_two {
         /// @param count размер контейнера
         /// @param alloc аллокатор, который будет использоваться для всех выделений памяти этого контейнера
         // Конструктор с count экземплярами T, вставленными по умолчанию
-        explicit ChunkList(size_type count, const Allocator &alloc = Allocator()) {
-
+        explicit ChunkList(size_type count, const Allocator &alloc = Allocator()) : alloc(alloc) {
+            init_fill(count);
         }
 
         /// @brief Конструирует контейнер с содержимым диапазона [first,
@@ -426,27 +2887,9 @@ namespace fefu_laboratory_two {
         /// @param first, last 	диапазон, из которого нужно скопировать элементы
         /// @param alloc аллокатор, который будет использоваться для всех выделений памяти этого контейнера
         // Конструктор с содержимым диапазона [first, last)
-        template<class InputIt>
-        ChunkList(InputIt first, InputIt last, Allocator alloc = Allocator()) {
-            std::list<value_type> init(first, last);
-            auto ptr = alloc.allocate(init.size());
-
-            auto current_ptr = ptr;
-            try {
-                for (const auto& element : init) {
-                    alloc.construct(current_ptr, element);
-                    ++current_ptr;
-                }
-            } catch (...) {
-                // If an exception occurs during construction, destroy constructed elements and rethrow
-                for (auto rollback_ptr = ptr; rollback_ptr != current_ptr; ++rollback_ptr) {
-                    alloc.deallocate();
-                }
-                alloc.deallocate();
-                throw;
-            }
-            p = ptr;
-            this->alloc = alloc;
+        template<class InputIt, typename = detail::enable_if_input_iterator<InputIt>>
+        ChunkList(InputIt first, InputIt last, Allocator alloc = Allocator()) : alloc(alloc) {
+            init_range(first, last);
         }
 
         /// @brief Конструктор копий. Конструирует контейнер с копией
@@ -454,7 +2897,10 @@ namespace fefu_laboratory_two {
         /// @param other другой контейнер, который будет использоваться в качестве источника для инициализации
         /// элементов контейнера
         // Конструктор копирования
-        ChunkList(const ChunkList &other) = default;
+        ChunkList(const ChunkList &other)
+                : alloc(alloc_traits::select_on_container_copy_construction(other.alloc)) {
+            copy_chunks(other);
+        }
 
         /// @brief Конструирует контейнер с копией содержимого other,
         /// используя alloc в качестве аллокатора.
@@ -462,8 +2908,8 @@ namespace fefu_laboratory_two {
         /// элементы контейнера с
         /// @param alloc аллокатор, который будет использоваться для всех выделений памяти этого контейнера
         // Конструктор копирования с аллокатором
-        ChunkList(const ChunkList &other, const Allocator &alloc) {
-
+        ChunkList(const ChunkList &other, const Allocator &alloc) : alloc(alloc) {
+            copy_chunks(other);
         }
 
         /**
@@ -471,14 +2917,17 @@ namespace fefu_laboratory_two {
          *
          * Конструирует контейнер с содержимым другого, используя семантику перемещения.
          * Аллокатор получается путем перемещения-конструкции из аллокатора, принадлежащего
-         * other.
+         * other. Чанки забираются без перемещения элементов; исключение - встроенный чанк
+         * при Options::inline_first_chunk, его элементы перемещаются по одному.
          *
          * @param other другой контейнер, который будет использоваться в качестве источника для инициализации
          * элементов контейнера
          */
         // Конструктор перемещения
-        ChunkList(ChunkList &&other) noexcept {
-
+        ChunkList(ChunkList &&other) noexcept(!Options::inline_first_chunk ||
+                                              std::is_nothrow_move_constructible_v<T>)
+                : alloc(std::move(other.alloc)) {
+            take_chain(other);
         }
 
         /**
@@ -492,8 +2941,12 @@ namespace fefu_laboratory_two {
          * @param alloc аллокатор, который будет использоваться для всех выделений памяти этого контейнера
          */
         // Расширенный конструктор перемещения с аллокатором
-        ChunkList(ChunkList &&other, const Allocator &alloc) {
-
+        ChunkList(ChunkList &&other, const Allocator &alloc) : alloc(alloc) {
+            if (alloc_traits::is_always_equal::value || this->alloc == other.alloc) {
+                take_chain(other);
+            } else {
+                init_range(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            }
         }
 
         /// @brief Создает контейнер с содержимым списка инициализатора
@@ -502,17 +2955,14 @@ namespace fefu_laboratory_two {
         /// с
         /// @param alloc аллокатор, который будет использоваться для всех выделений памяти этого контейнера
         // Конструктор с содержимым инициализирующего списка init
-        ChunkList(std::initializer_list<T> init, Allocator alloc = Allocator()) {
-            auto ptr = alloc.allocate(init.size());
-            alloc.construct(ptr, init);
-            p = ptr;
-            this->alloc = alloc;
+        ChunkList(std::initializer_list<T> init, Allocator alloc = Allocator()) : alloc(alloc) {
+            init_range(init.begin(), init.end());
         }
 
         /// @brief Уничтожает список ChunkList.
         // Деструктор
         ~ChunkList() {
-            alloc.deallocate();
+            clear();
         };
 
         /// @brief Оператор присвоения копий. Заменяет содержимое копией
@@ -521,6 +2971,14 @@ namespace fefu_laboratory_two {
         /// @return *this
         // Оператор присваивания копирования
         ChunkList &operator=(const ChunkList &other) {
+            if (this == &other) {
+                return *this;
+            }
+            clear();
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                alloc = other.alloc;
+            }
+            copy_chunks(other);
             return *this;
         }
 
@@ -531,12 +2989,34 @@ namespace fefu_laboratory_two {
          * (т. е. данные из other перемещаются в этот контейнер).
          * После этого other находится в допустимом, но неопределенном состоянии.
          *
+         * Если аллокатор распространяется при перемещении или аллокаторы равны, цепочка чанков
+         * забирается целиком за O(1) (со статистикой - за O(число чанков): чанки переводятся
+         * на счётчики этого контейнера), иначе элементы перемещаются по одному.
+         *
          * @param other другой контейнер для использования в качестве источника данных
          * @return *this
          */
         // Оператор присваивания перемещения
-        ChunkList &operator=(ChunkList &&other) {
-            return other;
+        ChunkList &operator=(ChunkList &&other) noexcept(
+                (alloc_traits::propagate_on_container_move_assignment::value ||
+                 alloc_traits::is_always_equal::value) &&
+                (!Options::inline_first_chunk || std::is_nothrow_move_constructible_v<T>)) {
+            if (this == &other) {
+                return *this;
+            }
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                clear();
+                alloc = std::move(other.alloc);
+                take_chain(other);
+            } else {
+                if (alloc_traits::is_always_equal::value || alloc == other.alloc) {
+                    clear();
+                    take_chain(other);
+                } else {
+                    assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                }
+            }
+            return *this;
         }
 
         /// @brief Заменяет содержимое на содержимое, указанное в списке инициализаторов
@@ -545,6 +3025,7 @@ namespace fefu_laboratory_two {
         /// @return this
         // Оператор присваивания инициализирующего списка
         ChunkList &operator=(std::initializer_list<T> ilist) {
+            assign(ilist);
             return *this;
         }
 
@@ -553,7 +3034,8 @@ namespace fefu_laboratory_two {
         /// @param value
         // Функция замены содержимого указанным количеством копий значения
         void assign(size_type count, const T &value) {
-
+            clear();
+            init_fill(count, value);
         }
 
         /// @brief Заменяет содержимое копиями содержимого в диапазоне [first,
@@ -562,9 +3044,10 @@ namespace fefu_laboratory_two {
         /// @param first
         /// @param last
         // Функция замены содержимого копиями элементов из диапазона [first, last)
-        template<class InputIt>
+        template<class InputIt, typename = detail::enable_if_input_iterator<InputIt>>
         void assign(InputIt first, InputIt last) {
-
+            clear();
+            init_range(first, last);
         }
 
         /// @brief Заменяет содержимое элементами из списка инициализаторов
@@ -572,14 +3055,15 @@ namespace fefu_laboratory_two {
         /// @param ilist
         // Функция замены содержимого элементами из инициализирующего списка
         void assign(std::initializer_list<T> ilist) {
-
+            clear();
+            init_range(ilist.begin(), ilist.end());
         }
 
         /// @brief Возвращает аллокатор, связанный с контейнером.
         /// @return Связанный аллокатор.
         // Возвращает аллокатор, связанный с контейнером
         allocator_type get_allocator() const noexcept {
-            return allocator_type();
+            return alloc;
         }
 
         /// ДОСТУП К ЭЛЕМЕНТУ
@@ -592,7 +3076,10 @@ namespace fefu_laboratory_two {
         /// @throw std::out_of_range
         // Возвращает ссылку на элемент по указанному местоположению с проверкой границ
         reference at(size_type pos) {
-
+            if (pos >= length) {
+                throw std::out_of_range("ChunkList::at(): pos is out of range");
+            }
+            return *locate(pos);
         }
 
         /// @brief Возвращает const ссылку на элемент в указанном месте pos,
@@ -603,7 +3090,10 @@ namespace fefu_laboratory_two {
         /// @throw std::out_of_range
         // Возвращает константную ссылку на элемент по указанному местоположению с проверкой границ
         const_reference at(size_type pos) const {
-
+            if (pos >= length) {
+                throw std::out_of_range("ChunkList::at() const: pos is out of range");
+            }
+            return *locate(pos);
         }
 
         /// @brief Возвращает ссылку на элемент в указанном месте pos. Никакой
@@ -612,7 +3102,7 @@ namespace fefu_laboratory_two {
         /// @return Ссылка на запрашиваемый элемент.
         // Возвращает ссылку на элемент по указанному местоположению без проверки границreference operator[](size_type pos);
         reference operator[](size_type pos) {
-
+            return *locate(pos);
         }
 
         /// @brief Возвращает const ссылку на элемент в указанном месте pos.
@@ -621,15 +3111,51 @@ namespace fefu_laboratory_two {
         /// @return Const Ссылка на запрашиваемый элемент.
         // Возвращает константную ссылку на элемент по указанному местоположению без проверки границ
         const_reference operator[](size_type pos) const {
-
+            return *locate(pos);
         }
 
+        /// @brief Курсор позиционного доступа: помнит чанк, к которому обращались последним, и
+        /// номер его первого элемента, поэтому обращения к близким позициям (c[i], c[i + 1],
+        /// c[i + 3]) стоят O(1) амортизированно, дальние - как operator[] контейнера.
+        /// operator[] и at() самого контейнера обращений не запоминают: курсор заводится там,
+        /// где нужен, и используется одним потоком.
+        /// Курсор остаётся действительным при изменении контейнера: первое обращение после
+        /// изменения находит позицию заново, как operator[], и дальше снова идёт от пальца.
+        template<bool Const>
+        class basic_cursor {
+            using list_type = std::conditional_t<Const, const ChunkList, ChunkList>;
+            using element_reference = std::conditional_t<Const, const T &, T &>;
+
+            list_type *list;
+            finger_type finger;
+
+        public:
+            explicit basic_cursor(list_type &list) noexcept : list(&list) {
+            }
+
+            // Возвращает ссылку на элемент с номером pos без проверки границ
+            element_reference operator[](size_type pos) {
+                return *list->seek(finger, pos);
+            }
+
+            // Возвращает ссылку на элемент с номером pos с проверкой границ
+            element_reference at(size_type pos) {
+                if (pos >= list->size()) {
+                    throw std::out_of_range("ChunkList::cursor::at(): pos is out of range");
+                }
+                return *list->seek(finger, pos);
+            }
+        };
+
+        using cursor = basic_cursor<false>;
+        using const_cursor = basic_cursor<true>;
+
         /// @brief Возвращает ссылку на первый элемент в контейнере.
         /// Вызов front для пустого контейнера не определен.
         /// Ссылка на первый элемент
         // Возвращает ссылку на первый элемент в контейнере
         reference front() {
-
+            return data(sentinel.next)[0];
         }
 
         /// @brief Возвращает const ссылку на первый элемент в контейнере.
@@ -637,7 +3163,7 @@ namespace fefu_laboratory_two {
         /// @return Const ссылка на первый элемент
         // Возвращает константную ссылку на первый элемент в контейнере
         const_reference front() const {
-
+            return data(sentinel.next)[0];
         }
 
         /// @brief Возвращает ссылку на последний элемент в контейнере.
@@ -645,12 +3171,7 @@ namespace fefu_laboratory_two {
         /// @return Ссылка на последний элемент.
         // Возвращает ссылку на последний элемент в контейнере
         reference back() {
-            //        if (empty()) {
-//            throw std::out_of_range("ChunkList::back(): container is empty");
-//        }
-//
-//        // Возвращаем ссылку на последний элемент
-//        return tail_->data[tail_->size - 1];
+            return data(sentinel.prev)[sentinel.prev->count - 1];
         }
 
         /// @brief Возвращает const ссылку на последний элемент в контейнере.
@@ -658,12 +3179,7 @@ namespace fefu_laboratory_two {
         /// @return Const Ссылка на последний элемент.
         // Возвращает константную ссылку на последний элемент в контейнере
         const_reference back() const {
-            //        if (empty()) {
-//            throw std::out_of_range("ChunkList::back() const: container is empty");
-//        }
-//
-//        // Возвращаем const ссылку на последний элемент
-//        return tail_->data[tail_->size - 1];
+            return data(sentinel.prev)[sentinel.prev->count - 1];
         }
 
         /// ИТЕРАТОРЫ
@@ -673,9 +3189,7 @@ namespace fefu_laboratory_two {
         /// @return Итератор к первому элементу.
         // Возвращает итератор на первый элемент ChunkList
         iterator begin() noexcept {
-            ChunkList_iterator<value_type> iteratorParams(p);
-
-            return iteratorParams;
+            return iterator(sentinel.next, 0);
         }
 
         /// @brief Возвращает итератор к первому элементу списка ChunkList.
@@ -683,13 +3197,13 @@ namespace fefu_laboratory_two {
         /// @return Итератор к первому элементу.
         // Возвращает константный итератор на первый элемент ChunkList
         const_iterator begin() const noexcept {
-
+            return const_iterator(sentinel.next, 0);
         }
 
         /// @brief То же самое, что и begin()
         // Возвращает константный итератор на первый элемент ChunkList (аналогично begin())
         const_iterator cbegin() const noexcept {
-
+            return begin();
         }
 
         /// @brief Возвращает итератор к элементу, следующему за последним элементом
@@ -698,9 +3212,7 @@ namespace fefu_laboratory_two {
         /// @return Итератор к элементу, следующему за последним элементом.
         // Возвращает итератор на элемент, следующий за последним элементом ChunkList
         iterator end() noexcept {
-            ChunkList_iterator<T> iteratorParams(p + N);
-
-            return iteratorParams;
+            return iterator(&sentinel, 0);
         }
 
         /// @brief Возвращает постоянный итератор к элементу, следующему за последним
@@ -709,13 +3221,28 @@ namespace fefu_laboratory_two {
         /// @return Постоянный итератор к элементу, следующему за последним элементом.
         // Возвращает константный итератор на элемент, следующий за последним элементом ChunkList
         const_iterator end() const noexcept {
-
+            return const_iterator(end_node(), 0);
         }
 
         /// @brief То же самое, что и end()
         // Возвращает константный итератор на элемент, следующий за последним элементом ChunkList (аналогично end())
         const_iterator cend() const noexcept {
+            return end();
+        }
+
+        /// @brief Возвращает диапазон чанков: каждый элемент диапазона - std::span с элементами
+        /// одного чанка, в порядке следования. Пустых чанков в диапазоне нет.
+        /// @return Диапазон чанков контейнера.
+        // Возвращает диапазон чанков контейнера
+        ChunkList_chunk_range<T> chunks() noexcept {
+            return ChunkList_chunk_range<T>(&sentinel);
+        }
 
+        /// @brief Возвращает диапазон чанков с константным доступом к элементам.
+        /// @return Диапазон чанков контейнера.
+        // Возвращает константный диапазон чанков контейнера
+        ChunkList_chunk_range<const T> chunks() const noexcept {
+            return ChunkList_chunk_range<const T>(end_node());
         }
 
         /// ВМЕСТИМОСТЬ
@@ -724,14 +3251,14 @@ namespace fefu_laboratory_two {
         /// @return  true, если контейнер пуст, false в противном случае
         // Проверяет, пуст ли контейнер
         bool empty() const noexcept {
-            return false;
+            return length == 0;
         }
 
         /// @brief Возвращает количество элементов в контейнере
         /// @return Количество элементов в контейнере.
         // Возвращает количество элементов в контейнере
         size_type size() const noexcept {
-            return 0;
+            return length;
         }
 
         /// @brief Возвращает максимальное количество элементов, которые может содержать контейнер
@@ -739,7 +3266,10 @@ namespace fefu_laboratory_two {
         /// @return Максимальное количество элементов.
         // Возвращает максимальное количество элементов, которые контейнер может содержать
         size_type max_size() const noexcept {
-            return 0;
+            chunk_allocator chunk_alloc(alloc);
+            size_type chunks = chunk_alloc_traits::max_size(chunk_alloc);
+            auto limit = static_cast<size_type>(std::numeric_limits<difference_type>::max());
+            return chunks > limit / chunk_size ? limit : chunks * chunk_size;
         }
 
         /// @brief Запрашивает удаление неиспользуемой памяти.
@@ -748,7 +3278,139 @@ namespace fefu_laboratory_two {
         /// Прошедший конец итератор также аннулируется.
         // Запрашивает уменьшение неиспользуемой емкости
         void shrink_to_fit() {
+            if (sentinel.next == &sentinel) {
+                return;
+            }
+            // Элементы переезжают вперёд: чанк dst заполняется из следующих за ним чанков,
+            // опустевшие чанки освобождаются. Каждый элемент перемещается не более двух раз.
+            node_type *dst = sentinel.next;
+            node_type *src = dst->next;
+            while (src != &sentinel) {
+                size_type moved = std::min(chunk_size - dst->count, src->count);
+                if (moved == 0) {
+                    dst = src;
+                    src = src->next;
+                    continue;
+                }
+                move_front(src, moved, dst);
+                if (src->count == 0) {
+                    node_type *next = src->next;
+                    release_chunk(src);
+                    src = next;
+                } else {
+                    dst = src;
+                    src = src->next;
+                }
+            }
+        }
+
+        /// @brief Частично уплотняет контейнер: соседние чанки, чьи элементы помещаются в один
+        /// чанк, сливаются, а освободившиеся чанки возвращаются аллокатору. В отличие от
+        /// shrink_to_fit объём работы ограничен: в budget входят и переносимые элементы, и
+        /// элементы чанка-приёмника, которые сдвигаются к началу его массива, если за ними не
+        /// хватает места. Все итераторы и ссылки аннулируются.
+        /// @param budget максимальное число перемещаемых элементов
+        /// @return Количество освобождённых чанков.
+        // Сливает недозаполненные соседние чанки, перемещая не более budget элементов
+        size_type compact(size_type budget) {
+            size_type freed = 0;
+            node_type *node = sentinel.next;
+            while (node != &sentinel && node->next != &sentinel) {
+                node_type *next = node->next;
+                if (node->count + next->count > chunk_size) {
+                    node = next;
+                    continue;
+                }
+                // Если за элементами node не хватает места, move_front сначала сдвигает их
+                size_type cost = next->count + (back_room(node) < next->count ? node->count : 0);
+                if (cost > budget) {
+                    break;
+                }
+                budget -= cost;
+                move_front(next, next->count, node);
+                release_chunk(next);
+                ++freed;
+            }
+            return freed;
+        }
+
+        /// @brief Доля занятых ячеек во всех выделенных чанках. Низкое значение говорит о том,
+        /// что после удалений осталось много полупустых чанков и стоит вызвать compact или
+        /// shrink_to_fit.
+        /// @return Отношение size() к ёмкости выделенных чанков; 1 для пустого контейнера.
+        // Возвращает заполненность чанков
+        double fill_ratio() const noexcept {
+            if (chunk_count == 0) {
+                return 1.0;
+            }
+            return static_cast<double>(length) / static_cast<double>(chunk_count * chunk_size);
+        }
+
+        /// @brief Память, которую контейнер держит в куче: чанки из аллокатора (заголовки и
+        /// ячейки элементов, в том числе пустые) и узлы индекса позиций. Встроенный чанк
+        /// лежит в самом объекте и не учитывается; память, которой владеют сами элементы
+        /// (например, буферы строк), тоже.
+        /// @return Число байт.
+        // Возвращает объём памяти, выделенной контейнером
+        size_type bytes_reserved() const noexcept {
+            size_type heap_chunks = chunk_count;
+            if constexpr (Options::inline_first_chunk) {
+                heap_chunks -= embedded.used ? 1 : 0;
+            }
+            return heap_chunks * sizeof(chunk_storage) + index.bytes();
+        }
+
+        /// @brief Память, занятая живыми элементами: size() * sizeof(T).
+        /// @return Число байт.
+        // Возвращает объём памяти под живые элементы
+        size_type bytes_used() const noexcept {
+            return length * sizeof(T);
+        }
 
+        /// @brief Доля накладных расходов: часть памяти чанков (включая встроенный) и индекса,
+        /// не занятая живыми элементами.
+        /// @return Значение из [0, 1); 0 для контейнера без чанков.
+        // Возвращает долю памяти, не занятой элементами
+        double overhead_ratio() const noexcept {
+            size_type total = chunk_count * sizeof(chunk_storage) + index.bytes();
+            if (total == 0) {
+                return 0.0;
+            }
+            return 1.0 - static_cast<double>(bytes_used()) / static_cast<double>(total);
+        }
+
+        /// @brief Гистограмма заполненности чанков: элемент i - число чанков, заполненных
+        /// больше чем на i / buckets и не больше чем на (i + 1) / buckets. Много чанков в
+        /// нижних корзинах говорит о фрагментации.
+        /// @param buckets число корзин
+        /// @return Вектор из buckets счётчиков.
+        // Возвращает распределение чанков по заполненности
+        std::vector<size_type> fill_histogram(size_type buckets = 10) const {
+            std::vector<size_type> histogram(buckets);
+            if (buckets == 0) {
+                return histogram;
+            }
+            for (const node_type *node = sentinel.next; node != &sentinel; node = node->next) {
+                ++histogram[(node->count * buckets - 1) / chunk_size];
+            }
+            return histogram;
+        }
+
+        /// @brief Счётчики операций контейнера. Ведутся, если в параметрах выбрана политика
+        /// chunk_list_stats: struct my_options : chunk_list_options { using stats = chunk_list_stats; };
+        /// С политикой no_stats по умолчанию объект счётчиков пуст. Константные методы тоже
+        /// обновляют счётчики, поэтому с включённой статистикой одновременные обращения к
+        /// контейнеру из разных потоков не допускаются.
+        /// @return Ссылка на счётчики.
+        // Возвращает счётчики операций
+        const typename Options::stats &stats() const noexcept {
+            return counters;
+        }
+
+        /// @brief Обнуляет счётчики операций.
+        // Обнуляет счётчики операций
+        void reset_stats() noexcept {
+            counters = typename Options::stats();
         }
 
         /// МОДИФИКАТОРЫ
@@ -758,7 +3420,16 @@ namespace fefu_laboratory_two {
         /// элементы. Любые итераторы, находящиеся в конце, также аннулируются.
         // Очищает контейнер, удаляя все элементы
         void clear() noexcept {
-
+            // Индекс освобождается целиком, чтобы не убирать из него чанки по одному
+            index.reset(alloc);
+            node_type *node = sentinel.next;
+            while (node != &sentinel) {
+                node_type *next = node->next;
+                std::destroy(data(node), data(node) + node->count);
+                release_chunk(node);
+                node = next;
+            }
+            length = 0;
         }
 
         /// @brief Вставляет значение перед pos.
@@ -767,7 +3438,7 @@ namespace fefu_laboratory_two {
         /// @return указывающий на вставленное значение.
         // Вставляет элемент перед указанным положением pos
         iterator insert(const_iterator pos, const T &value) {
-
+            return emplace_at(pos.node, pos.offset, value);
         }
 
         /// @brief Вставляет значение перед pos.
@@ -776,7 +3447,7 @@ namespace fefu_laboratory_two {
         /// @return Итератор, указывающий на вставленное значение.
         // Вставляет элемент перед указанным положением pos
         iterator insert(const_iterator pos, T &&value) {
-
+            return emplace_at(pos.node, pos.offset, std::move(value));
         }
 
         /// @brief Вставляет счетные копии значения перед pos.
@@ -787,7 +3458,19 @@ namespace fefu_laboratory_two {
         /// == 0.
         // Вставляет count копий значения перед указанным положением pos
         iterator insert(const_iterator pos, size_type count, const T &value) {
-
+            if (count <= 1) {
+                return count == 0 ? iterator(pos.node, pos.offset) : emplace_at(pos.node, pos.offset, value);
+            }
+            // value может быть элементом этого же списка: разбиение чанка перемещает хвост,
+            // поэтому копия снимается до открытия места вставки
+            const T copy(value);
+            node_type *head = append_to(open_insert_point(pos.node, pos.offset), copy);
+            size_type head_offset = head->count - 1;
+            node_type *node = head;
+            for (size_type i = 1; i < count; ++i) {
+                node = append_to(node, copy);
+            }
+            return iterator(head, head_offset);
         }
 
         /// @brief Вставляет элементы из диапазона [first, last) перед pos.
@@ -798,9 +3481,9 @@ namespace fefu_laboratory_two {
         /// @return Итератор, указывающий на первый вставленный элемент, или pos, если first
         /// == last.
         // Вставляет элементы из диапазона [first, last) перед указанным положением pos
-        template<class InputIt>
+        template<class InputIt, typename = detail::enable_if_input_iterator<InputIt>>
         iterator insert(const_iterator pos, InputIt first, InputIt last) {
-
+            return insert_range_at(pos.node, pos.offset, first, last);
         }
 
         /// @brief Вставляет элементы из списка инициализаторов перед pos.
@@ -810,7 +3493,7 @@ namespace fefu_laboratory_two {
         /// пуст.
         // Вставляет элементы из инициализирующего списка перед указанным положением pos
         iterator insert(const_iterator pos, std::initializer_list<T> ilist) {
-
+            return insert_range_at(pos.node, pos.offset, ilist.begin(), ilist.end());
         }
 
         /// @brief Вставляет новый элемент в контейнер непосредственно перед pos.
@@ -820,7 +3503,7 @@ namespace fefu_laboratory_two {
         // Вставляет новый элемент непосредственно перед указанным положением pos
         template<class... Args>
         iterator emplace(const_iterator pos, Args &&... args) {
-
+            return emplace_at(pos.node, pos.offset, std::forward<Args>(args)...);
         }
 
         /// @brief Удаляет элемент в позиции pos.
@@ -828,7 +3511,7 @@ namespace fefu_laboratory_two {
         /// @return Итератор, следующий за последним удаленным элементом.
         // Удаляет элемент в позиции pos
         iterator erase(const_iterator pos) {
-
+            return erase_at(pos.node, pos.offset);
         }
 
         /// @brief Удаляет элементы в диапазоне [first, last).
@@ -836,7 +3519,54 @@ namespace fefu_laboratory_two {
         /// @return следующий за последним удаленным элементом.
         // Удаляет элементы в диапазоне [first, last)
         iterator erase(const_iterator first, const_iterator last) {
+            if (first == last) {
+                return iterator(last.node, last.offset);
+            }
+            if (first.node == last.node) {
+                return erase_span(first.node, first.offset, last.offset);
+            }
+            // Полностью покрытые чанки освобождаются целиком, сдвиг нужен только в последнем
+            node_type *node = first.node->next;
+            erase_span(first.node, first.offset, first.node->count);
+            while (node != last.node) {
+                node_type *next = node->next;
+                std::destroy(data(node), data(node) + node->count);
+                length -= node->count;
+                count_changed(node, -static_cast<difference_type>(node->count));
+                node->count = 0;
+                release_chunk(node);
+                node = next;
+            }
+            if (last.offset == 0) {
+                return iterator(last.node, 0);
+            }
+            return erase_span(last.node, 0, last.offset);
+        }
+
+        /// @brief Удаляет все элементы, равные value. Для арифметических T первое совпадение в
+        /// каждом чанке ищется векторно.
+        /// @param value значение удаляемых элементов
+        /// @return Количество удаленных элементов.
+        // Удаляет все элементы, равные value
+        size_type remove(const T &value) {
+            if constexpr (std::is_copy_constructible_v<T>) {
+                // value может ссылаться на элемент самого контейнера, который будет перезаписан
+                const T copy = value;
+                return remove_matching([&copy](T *first, T *last) { return detail::simd::find(first, last, copy); },
+                                       [&copy](const T &element) { return element == copy; });
+            } else {
+                return remove_matching([&value](T *first, T *last) { return std::find(first, last, value); },
+                                       [&value](const T &element) { return element == value; });
+            }
+        }
 
+        /// @brief Удаляет все элементы, для которых pred возвращает true.
+        /// @param pred унарный предикат
+        /// @return Количество удаленных элементов.
+        // Удаляет все элементы, удовлетворяющие предикату
+        template<class Predicate>
+        size_type remove_if(Predicate pred) {
+            return remove_matching([&pred](T *first, T *last) { return std::find_if(first, last, pred); }, pred);
         }
 
         /// @brief Добавляет заданное значение элемента в конец контейнера.
@@ -844,7 +3574,7 @@ namespace fefu_laboratory_two {
         /// @param value значение элемента для добавления
         // Добавляет элемент в конец контейнера
         void push_back(const T &value) {
-
+            append_to(sentinel.prev, value);
         }
 
         /// @brief Добавляет заданное значение элемента в конец контейнера.
@@ -852,7 +3582,7 @@ namespace fefu_laboratory_two {
         /// @param value value значение элемента для добавления
         // Добавляет элемент в конец контейнера с использованием std::move
         void push_back(T &&value) {
-
+            append_to(sentinel.prev, std::move(value));
         }
 
         /// @brief Добавляет новый элемент в конец контейнера.
@@ -861,42 +3591,48 @@ namespace fefu_laboratory_two {
         // Вставляет новый элемент в конец контейнера
         template<class... Args>
         reference emplace_back(Args &&... args) {
-
+            node_type *node = append_to(sentinel.prev, std::forward<Args>(args)...);
+            return data(node)[node->count - 1];
         }
 
         /// @brief Удаляет последний элемент контейнера.
         // Удаляет последний элемент из контейнера
         void pop_back() {
-
+            erase_at(sentinel.prev, sentinel.prev->count - 1);
         }
 
         /// @brief Добавляет значение заданного элемента в начало контейнера.
         /// @param value значение элемента, который нужно добавить
         // Добавляет элемент в начало контейнера
         void push_front(const T &value) {
-
+            prepend_to(sentinel.next, value);
         }
 
         /// @brief Добавляет значение заданного элемента в начало контейнера.
         /// @param value moved значение элемента для добавления
         // Добавляет элемент в начало контейнера с использованием std::move
         void push_front(T &&value) {
-
+            prepend_to(sentinel.next, std::move(value));
         }
 
         /// @brief Вставляет новый элемент в начало контейнера.
+        /// Существующие элементы не сдвигаются: элемент занимает свободную ячейку перед первым
+        /// элементом первого чанка или последнюю ячейку нового чанка, так что вставка в начало,
+        /// как и в конец, стоит O(1).
         /// @param ...args аргументы для передачи в конструктор элемента
         /// @return Ссылка на вставленный элемент.
         // Вставляет новый элемент в начало контейнера
         template<class... Args>
         reference emplace_front(Args &&... args) {
-
+            node_type *node = prepend_to(sentinel.next, std::forward<Args>(args)...);
+            return data(node)[0];
         }
 
         /// @brief Удаляет первый элемент контейнера.
+        /// Остальные элементы не сдвигаются.
         // Удаляет первый элемент из контейнера
         void pop_front() {
-
+            erase_at(sentinel.next, 0);
         }
 
         /// @brief Изменяет размер контейнера, чтобы он содержал count элементов.
@@ -906,7 +3642,12 @@ namespace fefu_laboratory_two {
         /// @param count новый размер контейнера
         // Изменяет размер контейнера, чтобы содержать count элементов
         void resize(size_type count) {
-
+            while (length > count) {
+                pop_back();
+            }
+            while (length < count) {
+                emplace_back();
+            }
         }
 
         /// @brief Изменяет размер контейнера, чтобы он содержал count элементов.
@@ -917,17 +3658,196 @@ namespace fefu_laboratory_two {
         /// @param value значение, которым инициализируются новые элементы
         // Изменяет размер контейнера, чтобы содержать count элементов и инициализирует новые элементы значением value
         void resize(size_type count, const value_type &value) {
+            while (length > count) {
+                pop_back();
+            }
+            if (length < count) {
+                // value может быть элементом списка, а дописывание уплотняет чанки и
+                // перемещает их элементы, поэтому копии снимаются с локального значения
+                const T copy(value);
+                while (length < count) {
+                    push_back(copy);
+                }
+            }
+        }
+
+        /// ОПЕРАЦИИ НАД СПИСКАМИ
+
+        /// @brief Переносит все элементы other в этот контейнер перед pos. Чанки other
+        /// перецепляются без копирования; элементы перемещаются только при делении чанка в
+        /// позиции pos и при слиянии недозаполненных чанков на стыках. Каждый из k перецеплённых
+        /// чанков заносится в индекс позиций за O(log C); если k сравнимо с числом чанков C,
+        /// индекс вместо этого перестраивается за O(C). Аллокаторы должны быть равны, other не
+        /// должен совпадать с *this.
+        /// Итераторы на элементы граничных чанков аннулируются.
+        /// @param pos позиция, перед которой вставляются элементы
+        /// @param other контейнер, из которого переносятся элементы
+        /// @throw std::invalid_argument, если other совпадает с *this
+        // Переносит все элементы другого контейнера
+        void splice(const_iterator pos, ChunkList &other) {
+            if (&other == this) {
+                throw std::invalid_argument("ChunkList::splice(): other is *this");
+            }
+            if (other.length == 0) {
+                return;
+            }
+            node_type *at = splice_point(pos.node, pos.offset);
+            if constexpr (Options::inline_first_chunk) {
+                if (other.embedded.used) {
+                    other.relocate_embedded(reinterpret_cast<node_type *>(&other.embedded.storage));
+                }
+            }
+            node_type *head = other.sentinel.next;
+            node_type *tail = other.sentinel.prev;
+            size_type elements = other.length;
+            size_type chunks = other.chunk_count;
+            other.sentinel.next = other.sentinel.prev = &other.sentinel;
+            other.length = other.chunk_count = 0;
+            other.index.reset(other.alloc);
+            link_chunks(at, head, tail, elements, chunks);
+        }
+
+        // Переносит все элементы временного контейнера
+        void splice(const_iterator pos, ChunkList &&other) {
+            splice(pos, other);
+        }
+
+        /// @brief Переносит элемент it из other в этот контейнер перед pos. Элемент
+        /// перемещается; если other совпадает с *this, элемент переставляется как диапазон
+        /// [it, it + 1).
+        /// @param pos позиция, перед которой вставляется элемент
+        /// @param other контейнер, из которого переносится элемент
+        /// @param it итератор на переносимый элемент
+        // Переносит один элемент другого контейнера
+        void splice(const_iterator pos, ChunkList &other, const_iterator it) {
+            if (&other == this) {
+                splice(pos, other, it, std::next(it));
+                return;
+            }
+            emplace_at(pos.node, pos.offset, std::move(*iterator(it.node, it.offset)));
+            other.erase(it);
+        }
+
+        // Переносит один элемент временного контейнера
+        void splice(const_iterator pos, ChunkList &&other, const_iterator it) {
+            splice(pos, other, it);
+        }
+
+        /// @brief Переносит элементы [first, last) из other в этот контейнер перед pos.
+        /// Полностью покрытые чанки перецепляются, граничные чанки делятся. Стоимость
+        /// пропорциональна размеру граничных чанков плюс числу перенесённых чанков k, умноженному
+        /// на O(log C) обновления индексов позиций обоих контейнеров (при k, сравнимом с числом
+        /// чанков, индекс перестраивается за O(C)).
+        /// Аллокаторы должны быть равны. Если other совпадает с *this, диапазон переставляется
+        /// перед pos внутри контейнера; pos не должен лежать внутри (first, last).
+        /// @param pos позиция, перед которой вставляются элементы
+        /// @param other контейнер, из которого переносятся элементы
+        /// @param first,last диапазон переносимых элементов other
+        /// @throw std::invalid_argument, если other совпадает с *this и pos лежит внутри (first, last)
+        // Переносит диапазон элементов другого контейнера
+        void splice(const_iterator pos, ChunkList &other, const_iterator first, const_iterator last) {
+            if (first == last) {
+                return;
+            }
+            if (&other == this) {
+                move_range(pos, first, last);
+                return;
+            }
+            if (first == other.cbegin() && last == other.cend()) {
+                splice(pos, other);
+                return;
+            }
+            node_type *at = splice_point(pos.node, pos.offset);
+            size_type elements;
+            size_type chunks;
+            auto [head, tail] = other.detach_chunks(first, last, elements, chunks);
+            link_chunks(at, head, tail, elements, chunks);
+        }
+
+        // Переносит диапазон элементов временного контейнера
+        void splice(const_iterator pos, ChunkList &&other, const_iterator first, const_iterator last) {
+            splice(pos, other, first, last);
+        }
 
+        /// @brief Отделяет хвост контейнера: элементы [pos, end()) переносятся в новый контейнер
+        /// перецеплением чанков, делится только чанк с позицией pos.
+        /// @param pos первый элемент хвоста
+        /// @return Контейнер с элементами [pos, end()).
+        // Отделяет хвост контейнера начиная с pos
+        ChunkList split_at(const_iterator pos) {
+            ChunkList tail(alloc);
+            tail.splice(tail.cend(), *this, pos, cend());
+            return tail;
+        }
+
+        /// @brief Сливает два отсортированных контейнера в один. Если диапазоны не
+        /// перекрываются, other целиком перецепляется в начало или конец как splice, без
+        /// перемещения элементов: стыковка цепочек стоит O(1), но каждый из k чанков other
+        /// заносится в индекс позиций за O(log C), а при большом k индекс перестраивается за O(C).
+        /// Иначе элементы перемещаются в новую плотную цепочку за O(size() + other.size()).
+        /// Слияние устойчиво: из равных элементов первыми идут элементы *this.
+        /// @param other контейнер для слияния
+        /// @param comp функция сравнения, возвращающая true, если первый аргумент меньше второго
+        // Сливает отсортированный контейнер other в этот
+        template<class Compare>
+        void merge(ChunkList &other, Compare comp) {
+            if (&other == this || other.length == 0) {
+                return;
+            }
+            if (length == 0 || !comp(other.front(), back())) {
+                splice(cend(), other);
+                return;
+            }
+            if (comp(other.back(), front())) {
+                splice(cbegin(), other);
+                return;
+            }
+            ChunkList merged(alloc);
+            std::merge(std::make_move_iterator(begin()), std::make_move_iterator(end()),
+                       std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()),
+                       std::back_inserter(merged), comp);
+            other.clear();
+            *this = std::move(merged);
+        }
+
+        // Сливает отсортированный временный контейнер other в этот
+        template<class Compare>
+        void merge(ChunkList &&other, Compare comp) {
+            merge(other, comp);
+        }
+
+        // Сливает отсортированный контейнер other в этот, сравнивая элементы оператором <
+        void merge(ChunkList &other) {
+            merge(other, std::less<>());
+        }
+
+        // Сливает отсортированный временный контейнер other в этот, сравнивая элементы оператором <
+        void merge(ChunkList &&other) {
+            merge(other, std::less<>());
         }
 
         /// @brief Обменивает содержимое контейнера на содержимое других контейнеров.
         /// Не вызывает никаких операций перемещения, копирования или замены отдельных элементов.
         /// Все итераторы и ссылки остаются в силе. Прошедший конец итератор
-        /// аннулируется.
+        /// аннулируется. При Options::inline_first_chunk элементы встроенных чанков
+        /// перемещаются, и итераторы на них аннулируются.
+        /// Аллокаторы обмениваются, если этого требует propagate_on_container_swap;
+        /// иначе они должны быть равны.
         /// @param other container to exchange the contents with
         // Обменивает содержимое контейнера с содержимым другого контейнера
-        void swap(ChunkList &other) {
-
+        void swap(ChunkList &other) noexcept(!Options::inline_first_chunk ||
+                                             std::is_nothrow_move_constructible_v<T>) {
+            if (this == &other) {
+                return;
+            }
+            if constexpr (alloc_traits::propagate_on_container_swap::value) {
+                using std::swap;
+                swap(alloc, other.alloc);
+            }
+            ChunkList buffer(alloc);
+            buffer.take_chain(*this);
+            take_chain(other);
+            other.take_chain(buffer);
         }
 
         /// СРАВНЕНИЯ
@@ -935,55 +3855,48 @@ namespace fefu_laboratory_two {
         /// @brief Проверяет, одинаково ли содержимое lhs и rhs.
         /// @param lhs,rhs ChunkLists, содержимое которых нужно сравнить
         // Оператор сравнения ==
-        template<class U, class Alloc>
-        friend bool operator==(const ChunkList<U, 0, Alloc> &lhs, const ChunkList<U, 0, Alloc> &rhs) {
-            return lhs == rhs;
+        friend bool operator==(const ChunkList &lhs, const ChunkList &rhs) {
+            return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
         }
 
         /// @brief Проверяет, не равно ли содержимое lhs и rhs.
         /// @param lhs,rhs ChunkLists, содержимое которых нужно сравнить
         // Оператор сравнения !=
-        template<class U, class Alloc>
-        friend bool operator!=(const ChunkList<U, 0, Alloc> &lhs, const ChunkList<U, 0, Alloc> &rhs) {
-            return lhs != rhs;
+        friend bool operator!=(const ChunkList &lhs, const ChunkList &rhs) {
+            return !(lhs == rhs);
         }
 
         /// @brief Сравнивает содержимое lhs и rhs лексикографически.
         /// @param lhs,rhs ChunkLists, содержимое которых нужно сравнить
         // Оператор сравнения >
-        template<class U, class Alloc>
-        friend bool operator>(const ChunkList<U, 0, Alloc> &lhs, const ChunkList<U, 0, Alloc> &rhs) {
-            return lhs > rhs;
+        friend bool operator>(const ChunkList &lhs, const ChunkList &rhs) {
+            return rhs < lhs;
         }
 
         /// @brief Сравнивает содержимое lhs и rhs лексикографически.
         /// @param lhs,rhs ChunkLists, содержимое которых нужно сравнить
         // Оператор сравнения <
-        template<class U, class Alloc>
-        friend bool operator<(const ChunkList<U, 0, Alloc> &lhs, const ChunkList<U, 0, Alloc> &rhs) {
-            return lhs < rhs;
+        friend bool operator<(const ChunkList &lhs, const ChunkList &rhs) {
+            return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
         }
 
         /// @brief Сравнивает содержимое lhs и rhs лексикографически.
         /// @param lhs,rhs ChunkLists, содержимое которых нужно сравнить
         // Оператор сравнения >=
-        template<class U, class Alloc>
-        friend bool operator>=(const ChunkList<U, 0, Alloc> &lhs, const ChunkList<U, 0, Alloc> &rhs) {
-            return lhs >= rhs;
+        friend bool operator>=(const ChunkList &lhs, const ChunkList &rhs) {
+            return !(lhs < rhs);
         }
 
         /// @brief Сравнивает содержимое lhs и rhs лексикографически.
         /// @param lhs,rhs ChunkLists, содержимое которых нужно сравнить
         // Оператор сравнения <=
-        template<class U, class Alloc>
-        friend bool operator<=(const ChunkList<U, 0, Alloc> &lhs, const ChunkList<U, 0, Alloc> &rhs) {
-            return lhs <= rhs;
+        friend bool operator<=(const ChunkList &lhs, const ChunkList &rhs) {
+            return !(rhs < lhs);
         }
 
         // Оператор сравнения <=>
-        template<class U, class Alloc>
-        friend bool operator<=>(const ChunkList<U, 0, Alloc> &lhs, const ChunkList<U, 0, Alloc> &rhs) {
-            return lhs <=> rhs;
+        friend auto operator<=>(const ChunkList &lhs, const ChunkList &rhs) requires std::three_way_comparable<T> {
+            return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
         }
     };
 
@@ -992,16 +3905,24 @@ namespace fefu_laboratory_two {
     /// @brief Меняет местами содержимое lhs и rhs.
     /// @param lhs,rhs контейнеры, содержимое которых нужно поменять местами
     // Функция обмена содержимым двух контейнеров
-    template<class T, class Alloc>
-    void swap(ChunkList<T, 0, Alloc> &lhs, ChunkList<T, 0, Alloc> &rhs);
+    template<class T, int N, class Alloc, class Options>
+    void swap(ChunkList<T, N, Alloc, Options> &lhs, ChunkList<T, N, Alloc, Options> &rhs) noexcept(noexcept(lhs.swap(rhs))) {
+        lhs.swap(rhs);
+    }
 
     /// @brief Стирает из контейнера все элементы, которые сравниваются с value.
     /// @param c контейнер, из которого нужно стереть
     /// @param value значение, которое должно быть удалено
     /// @return Количество стертых элементов.
     // Функция удаления всех элементов, равных заданному значению, из контейнера
-    template<class T, class Alloc, class U>
-    typename ChunkList<T, 0, Alloc>::size_type erase(ChunkList<T, 0, Alloc> &c, const U &value);
+    template<class T, int N, class Alloc, class Options, class U>
+    typename ChunkList<T, N, Alloc, Options>::size_type erase(ChunkList<T, N, Alloc, Options> &c, const U &value) {
+        if constexpr (std::is_same_v<U, T>) {
+            return c.remove(value);
+        } else {
+            return c.remove_if([&value](const T &element) { return element == value; });
+        }
+    }
 
     /// @brief Стирает из контейнера все элементы, которые сравниваются с value.
     /// @param c контейнер, из которого нужно стереть
@@ -1009,7 +3930,372 @@ namespace fefu_laboratory_two {
     /// удален.
     /// @return Количество стертых элементов.
     // Функция удаления всех элементов, удовлетворяющих предикату, из контейнера
-    template<class T, class Alloc, class Pred>
-    typename ChunkList<T, 0, Alloc>::size_type erase_if(ChunkList<T, 0, Alloc> &c, Pred pred);
+    template<class T, int N, class Alloc, class Options, class Pred>
+    typename ChunkList<T, N, Alloc, Options>::size_type erase_if(ChunkList<T, N, Alloc, Options> &c, Pred pred) {
+        return c.remove_if(pred);
+    }
+
+    /// ПАРАЛЛЕЛЬНЫЕ АЛГОРИТМЫ
+
+    /// @brief Вызывает f для каждого чанка list (std::span с его элементами), распределяя чанки
+    /// между потоками пула с перехватом работы. Вызывающий поток участвует в работе.
+    /// f вызывается одновременно из нескольких потоков; контейнер нельзя менять, пока
+    /// функция не вернулась. Первое исключение из f пробрасывается после завершения остальных
+    /// чанков.
+    /// @param list контейнер (константный или нет)
+    /// @param f функция, принимающая std::span<T> или std::span<const T>
+    // Параллельно применяет функцию к каждому чанку контейнера
+    template<class List, class Function>
+    void parallel_for_each_chunk(List &list, Function f) {
+        auto range = list.chunks();
+        std::vector<typename decltype(range)::iterator::value_type> parts(range.begin(), range.end());
+        auto job = [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                f(parts[i]);
+            }
+        };
+        detail::task_pool::instance().run(parts.size(), job);
+    }
+
+    /// @brief Вызывает f для каждого элемента list параллельно, поделив работу по чанкам.
+    /// Порядок вызовов не определён; f должна допускать одновременные вызовы.
+    /// @param list контейнер (константный или нет)
+    /// @param f функция, принимающая ссылку на элемент
+    // Параллельно применяет функцию к каждому элементу контейнера
+    template<class List, class Function>
+    void parallel_for_each(List &list, Function f) {
+        parallel_for_each_chunk(list, [&f](auto part) {
+            for (auto &value: part) {
+                f(value);
+            }
+        });
+    }
+
+    /// @brief Заменяет каждый элемент list результатом op(элемент), обрабатывая чанки
+    /// параллельно.
+    /// @param list контейнер
+    /// @param op унарная операция; должна допускать одновременные вызовы
+    // Параллельно преобразует элементы контейнера на месте
+    template<class T, int N, class Alloc, class Options, class UnaryOperation>
+    void parallel_transform(ChunkList<T, N, Alloc, Options> &list, UnaryOperation op) {
+        parallel_for_each_chunk(list, [&op](std::span<T> part) {
+            std::transform(part.begin(), part.end(), part.begin(), op);
+        });
+    }
+
+
+    namespace detail {
+
+        // Доступ сегментированных алгоритмов к позиции итератора
+        struct segment_access {
+            template<class It>
+            static chunk_header *node(const It &it) noexcept {
+                return it.node;
+            }
+
+            template<class It>
+            static std::size_t offset(const It &it) noexcept {
+                return it.offset;
+            }
+        };
+
+        // Обходит [first, last) непрерывными отрезками: f(node, begin, end) вызывается для части
+        // каждого чанка, попавшей в диапазон, пока f не вернёт false. Возвращает false, если
+        // обход прерван.
+        template<typename T, class It, class Function>
+        bool for_each_segment(const It &first, const It &last, Function f) {
+            chunk_header *node = segment_access::node(first);
+            std::size_t offset = segment_access::offset(first);
+            chunk_header *last_node = segment_access::node(last);
+            while (node != last_node) {
+                T *data = chunk_data<T>(node);
+                if (!f(node, data + offset, data + node->count)) {
+                    return false;
+                }
+                node = node->next;
+                count_hop(node);
+                offset = 0;
+            }
+            std::size_t last_offset = segment_access::offset(last);
+            if (offset == last_offset) {
+                return true;
+            }
+            T *data = chunk_data<T>(node);
+            return f(node, data + offset, data + last_offset);
+        }
+
+        template<typename T, class It, class U>
+        It segmented_find(It first, It last, const U &value) {
+            It found = last;
+            for_each_segment<T>(first, last, [&](chunk_header *node, T *begin, T *end) {
+                T *hit = simd::find(begin, end, value);
+                if (hit == end) {
+                    return true;
+                }
+                found = It(node, static_cast<std::size_t>(hit - chunk_data<T>(node)));
+                return false;
+            });
+            return found;
+        }
+
+        template<typename T, class It, class Predicate>
+        It segmented_find_if(It first, It last, Predicate pred) {
+            It found = last;
+            for_each_segment<T>(first, last, [&](chunk_header *node, T *begin, T *end) {
+                T *hit = std::find_if(begin, end, pred);
+                if (hit == end) {
+                    return true;
+                }
+                found = It(node, static_cast<std::size_t>(hit - chunk_data<T>(node)));
+                return false;
+            });
+            return found;
+        }
+
+        template<typename T, class It, class Predicate>
+        std::ptrdiff_t segmented_count_if(It first, It last, Predicate pred) {
+            std::ptrdiff_t result = 0;
+            for_each_segment<T>(first, last, [&](chunk_header *, T *begin, T *end) {
+                result += std::count_if(begin, end, pred);
+                return true;
+            });
+            return result;
+        }
+
+        template<typename T, class It, class U>
+        std::ptrdiff_t segmented_count(It first, It last, const U &value) {
+            std::size_t result = 0;
+            for_each_segment<T>(first, last, [&](chunk_header *, T *begin, T *end) {
+                result += simd::count(begin, end, value);
+                return true;
+            });
+            return static_cast<std::ptrdiff_t>(result);
+        }
+
+        // Первый наименьший элемент (Max = false) или первый наибольший (Max = true) по comp,
+        // как у std::min_element и std::max_element: лучший элемент переносится из отрезка в
+        // отрезок. Отдельно найденный экстремум отрезка совпадает с продолжением просмотра,
+        // только если первый элемент отрезка сравним с остальными. Поэтому векторные ядра
+        // берутся со сравнением по умолчанию для отрезков, начинающихся не с NaN, а прочие
+        // отрезки просматриваются подряд от лучшего элемента.
+        template<typename T, bool Max, class It, class Compare>
+        It segmented_extremum(It first, It last, Compare comp) {
+            It found = last;
+            T *best = nullptr;
+            auto better = [&](const T &candidate) {
+                return best == nullptr || (Max ? comp(*best, candidate) : comp(candidate, *best));
+            };
+            for_each_segment<T>(first, last, [&](chunk_header *node, T *begin, T *end) {
+                if constexpr (std::is_same_v<Compare, std::less<>>) {
+                    if (begin != end && !(simd::is_real<std::remove_const_t<T>> && *begin != *begin)) {
+                        T *candidate = simd::extremum<Max>(begin, end);
+                        if (better(*candidate)) {
+                            best = candidate;
+                            found = It(node, static_cast<std::size_t>(candidate - chunk_data<T>(node)));
+                        }
+                        return true;
+                    }
+                }
+                for (T *p = begin; p != end; ++p) {
+                    if (better(*p)) {
+                        best = p;
+                        found = It(node, static_cast<std::size_t>(p - chunk_data<T>(node)));
+                    }
+                }
+                return true;
+            });
+            return found;
+        }
+
+        template<typename T, class It, class Init, class BinaryOperation>
+        Init segmented_accumulate(It first, It last, Init init, BinaryOperation op) {
+            for_each_segment<T>(first, last, [&](chunk_header *, T *begin, T *end) {
+                init = simd::accumulate(begin, end, std::move(init), op);
+                return true;
+            });
+            return init;
+        }
+
+        template<typename T, class It, class OutputIt>
+        OutputIt segmented_copy(It first, It last, OutputIt out) {
+            for_each_segment<T>(first, last, [&](chunk_header *, T *begin, T *end) {
+                out = std::copy(begin, end, out);
+                return true;
+            });
+            return out;
+        }
+
+        template<typename T, class It, class InputIt>
+        bool segmented_equal(It first, It last, InputIt other) {
+            return for_each_segment<T>(first, last, [&](chunk_header *, T *begin, T *end) {
+                if constexpr (std::is_pointer_v<InputIt>) {
+                    // Отрезок против отрезка: std::equal сводится к memcmp для подходящих T
+                    if (!std::equal(begin, end, other)) {
+                        return false;
+                    }
+                    other += end - begin;
+                } else {
+                    for (; begin != end; ++begin, ++other) {
+                        if (!(*begin == *other)) {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            });
+        }
+    }
+
+    /// СЕГМЕНТИРОВАННЫЕ АЛГОРИТМЫ
+    /// Перегрузки стандартных алгоритмов для итераторов ChunkList. Диапазон обходится
+    /// отрезками, лежащими внутри одного чанка, и на каждом отрезке работает стандартный
+    /// алгоритм над указателями: без проверки границы чанка на каждом элементе и с
+    /// возможностью векторизации. Находятся поиском по аргументам при неквалифицированном
+    /// вызове (find(list.begin(), list.end(), x)); вызов std::find использует общий вариант.
+
+    /// @brief Ищет первый элемент [first, last), равный value.
+    /// @return Итератор на найденный элемент или last.
+    // Поиск значения по отрезкам чанков
+    template<class T, class U>
+    ChunkList_iterator<T> find(ChunkList_iterator<T> first, ChunkList_iterator<T> last, const U &value) {
+        return detail::segmented_find<T>(first, last, value);
+    }
+
+    // Поиск значения по отрезкам чанков (константные итераторы)
+    template<class T, class U>
+    ChunkList_const_iterator<T> find(ChunkList_const_iterator<T> first, ChunkList_const_iterator<T> last,
+                                     const U &value) {
+        return detail::segmented_find<const T>(first, last, value);
+    }
+
+    /// @brief Ищет первый элемент [first, last), для которого pred возвращает true.
+    /// @return Итератор на найденный элемент или last.
+    // Поиск по предикату по отрезкам чанков
+    template<class T, class Predicate>
+    ChunkList_iterator<T> find_if(ChunkList_iterator<T> first, ChunkList_iterator<T> last, Predicate pred) {
+        return detail::segmented_find_if<T>(first, last, pred);
+    }
+
+    // Поиск по предикату по отрезкам чанков (константные итераторы)
+    template<class T, class Predicate>
+    ChunkList_const_iterator<T> find_if(ChunkList_const_iterator<T> first, ChunkList_const_iterator<T> last,
+                                        Predicate pred) {
+        return detail::segmented_find_if<const T>(first, last, pred);
+    }
+
+    /// @brief Считает элементы [first, last), равные value.
+    /// @return Количество найденных элементов.
+    // Подсчёт значений по отрезкам чанков
+    template<class T, class U>
+    std::ptrdiff_t count(ChunkList_iterator<T> first, ChunkList_iterator<T> last, const U &value) {
+        return detail::segmented_count<T>(first, last, value);
+    }
+
+    // Подсчёт значений по отрезкам чанков (константные итераторы)
+    template<class T, class U>
+    std::ptrdiff_t count(ChunkList_const_iterator<T> first, ChunkList_const_iterator<T> last, const U &value) {
+        return detail::segmented_count<const T>(first, last, value);
+    }
+
+    /// @brief Считает элементы [first, last), для которых pred возвращает true.
+    /// @return Количество найденных элементов.
+    // Подсчёт по предикату по отрезкам чанков
+    template<class T, class Predicate>
+    std::ptrdiff_t count_if(ChunkList_iterator<T> first, ChunkList_iterator<T> last, Predicate pred) {
+        return detail::segmented_count_if<T>(first, last, pred);
+    }
+
+    // Подсчёт по предикату по отрезкам чанков (константные итераторы)
+    template<class T, class Predicate>
+    std::ptrdiff_t count_if(ChunkList_const_iterator<T> first, ChunkList_const_iterator<T> last, Predicate pred) {
+        return detail::segmented_count_if<const T>(first, last, pred);
+    }
+
+    /// @brief Ищет первый наименьший элемент [first, last) по comp.
+    /// @return Итератор на найденный элемент или last для пустого диапазона.
+    // Поиск наименьшего элемента по отрезкам чанков
+    template<class T, class Compare = std::less<>>
+    ChunkList_iterator<T> min_element(ChunkList_iterator<T> first, ChunkList_iterator<T> last,
+                                      Compare comp = Compare()) {
+        return detail::segmented_extremum<T, false>(first, last, comp);
+    }
+
+    // Поиск наименьшего элемента по отрезкам чанков (константные итераторы)
+    template<class T, class Compare = std::less<>>
+    ChunkList_const_iterator<T> min_element(ChunkList_const_iterator<T> first, ChunkList_const_iterator<T> last,
+                                            Compare comp = Compare()) {
+        return detail::segmented_extremum<const T, false>(first, last, comp);
+    }
+
+    /// @brief Ищет первый наибольший элемент [first, last) по comp.
+    /// @return Итератор на найденный элемент или last для пустого диапазона.
+    // Поиск наибольшего элемента по отрезкам чанков
+    template<class T, class Compare = std::less<>>
+    ChunkList_iterator<T> max_element(ChunkList_iterator<T> first, ChunkList_iterator<T> last,
+                                      Compare comp = Compare()) {
+        return detail::segmented_extremum<T, true>(first, last, comp);
+    }
+
+    // Поиск наибольшего элемента по отрезкам чанков (константные итераторы)
+    template<class T, class Compare = std::less<>>
+    ChunkList_const_iterator<T> max_element(ChunkList_const_iterator<T> first, ChunkList_const_iterator<T> last,
+                                            Compare comp = Compare()) {
+        return detail::segmented_extremum<const T, true>(first, last, comp);
+    }
+
+    /// @brief Сворачивает [first, last) слева направо: init = op(init, элемент).
+    /// @return Результат свёртки.
+    // Свёртка по отрезкам чанков
+    template<class T, class Init, class BinaryOperation = std::plus<>>
+    Init accumulate(ChunkList_iterator<T> first, ChunkList_iterator<T> last, Init init,
+                    BinaryOperation op = BinaryOperation()) {
+        return detail::segmented_accumulate<T>(first, last, std::move(init), op);
+    }
+
+    // Свёртка по отрезкам чанков (константные итераторы)
+    template<class T, class Init, class BinaryOperation = std::plus<>>
+    Init accumulate(ChunkList_const_iterator<T> first, ChunkList_const_iterator<T> last, Init init,
+                    BinaryOperation op = BinaryOperation()) {
+        return detail::segmented_accumulate<const T>(first, last, std::move(init), op);
+    }
+
+    /// @brief Копирует [first, last) в out; отрезки тривиально копируемых элементов
+    /// копируются через memmove, если out - указатель.
+    /// @return Итератор за последним записанным элементом.
+    // Копирование по отрезкам чанков
+    template<class T, class OutputIt>
+    OutputIt copy(ChunkList_iterator<T> first, ChunkList_iterator<T> last, OutputIt out) {
+        return detail::segmented_copy<T>(first, last, out);
+    }
+
+    // Копирование по отрезкам чанков (константные итераторы)
+    template<class T, class OutputIt>
+    OutputIt copy(ChunkList_const_iterator<T> first, ChunkList_const_iterator<T> last, OutputIt out) {
+        return detail::segmented_copy<const T>(first, last, out);
+    }
+
+    /// @brief Присваивает value всем элементам [first, last).
+    // Заполнение по отрезкам чанков
+    template<class T, class U>
+    void fill(ChunkList_iterator<T> first, ChunkList_iterator<T> last, const U &value) {
+        detail::for_each_segment<T>(first, last, [&value](detail::chunk_header *, T *begin, T *end) {
+            std::fill(begin, end, value);
+            return true;
+        });
+    }
+
+    /// @brief Проверяет, что [first, last) поэлементно равен диапазону, начинающемуся с other.
+    /// @return true, если все элементы равны.
+    // Сравнение по отрезкам чанков
+    template<class T, class InputIt>
+    bool equal(ChunkList_iterator<T> first, ChunkList_iterator<T> last, InputIt other) {
+        return detail::segmented_equal<T>(first, last, other);
+    }
+
+    // Сравнение по отрезкам чанков (константные итераторы)
+    template<class T, class InputIt>
+    bool equal(ChunkList_const_iterator<T> first, ChunkList_const_iterator<T> last, InputIt other) {
+        return detail::segmented_equal<const T>(first, last, other);
+    }
 
 }
\ No newline at end of file
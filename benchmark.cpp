@@ -0,0 +1,195 @@
+#include "ChunkList.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <random>
+#include <vector>
+
+using namespace fefu_laboratory_two;
+
+namespace {
+
+    // Крупный элемент: 64 байта, как у типичной записи с несколькими полями
+    struct payload64 {
+        std::array<std::uint64_t, 8> words{};
+    };
+
+    template<typename T>
+    T make_value(std::size_t i) {
+        if constexpr (std::is_same_v<T, payload64>) {
+            payload64 value;
+            value.words[0] = i;
+            return value;
+        } else {
+            return static_cast<T>(i);
+        }
+    }
+
+    template<typename T>
+    std::uint64_t key_of(const T &value) {
+        if constexpr (std::is_same_v<T, payload64>) {
+            return value.words[0];
+        } else {
+            return static_cast<std::uint64_t>(value);
+        }
+    }
+
+    template<typename T> using chunk_list_16 = ChunkList<T, 16>;
+    template<typename T> using chunk_list_64 = ChunkList<T, 64>;
+    template<typename T> using chunk_list_256 = ChunkList<T, 256>;
+    template<typename T> using chunk_list_auto = ChunkList<T, 0>;
+
+    template<class C>
+    C make_filled(std::size_t count) {
+        C c;
+        for (std::size_t i = 0; i < count; ++i) {
+            c.push_back(make_value<typename C::value_type>(i));
+        }
+        return c;
+    }
+
+    template<class C>
+    void BM_push_back(benchmark::State &state) {
+        auto count = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state) {
+            C c;
+            for (std::size_t i = 0; i < count; ++i) {
+                c.push_back(make_value<typename C::value_type>(i));
+            }
+            benchmark::DoNotOptimize(c);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template<class C>
+    void BM_push_front(benchmark::State &state) {
+        auto count = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state) {
+            C c;
+            for (std::size_t i = 0; i < count; ++i) {
+                c.emplace_front(make_value<typename C::value_type>(i));
+            }
+            benchmark::DoNotOptimize(c);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Вставка и удаление в середине: учитывается и поиск позиции, и сдвиг элементов
+    template<class C>
+    void BM_mid_insert_erase(benchmark::State &state) {
+        auto count = static_cast<std::size_t>(state.range(0));
+        C c = make_filled<C>(count);
+        auto value = make_value<typename C::value_type>(count);
+        for (auto _ : state) {
+            auto it = c.insert(std::next(c.begin(), static_cast<std::ptrdiff_t>(count / 2)), value);
+            c.erase(it);
+        }
+        state.SetItemsProcessed(state.iterations() * 2);
+    }
+
+    template<class C>
+    void BM_iterate(benchmark::State &state) {
+        C c = make_filled<C>(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state) {
+            std::uint64_t sum = 0;
+            for (const auto &value : c) {
+                sum += key_of(value);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Неквалифицированный вызов: для ChunkList выбирается сегментированный count,
+    // для стандартных контейнеров - std::count
+    template<class C>
+    void BM_count(benchmark::State &state) {
+        C c = make_filled<C>(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state) {
+            auto found = count(c.begin(), c.end(), 7);
+            benchmark::DoNotOptimize(found);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template<class C>
+    void BM_random_index(benchmark::State &state) {
+        auto count = static_cast<std::size_t>(state.range(0));
+        C c = make_filled<C>(count);
+        std::mt19937_64 rng(42);
+        std::vector<std::size_t> positions(1024);
+        for (auto &pos : positions) {
+            pos = rng() % count;
+        }
+        for (auto _ : state) {
+            std::uint64_t sum = 0;
+            for (std::size_t pos : positions) {
+                sum += key_of(c[pos]);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(positions.size()));
+    }
+
+    // Удаление каждого третьего элемента. Неквалифицированный erase_if: для ChunkList
+    // сжатие идёт внутри чанков, для стандартных контейнеров - std::erase_if
+    template<class C>
+    void BM_erase_if(benchmark::State &state) {
+        auto count = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state) {
+            state.PauseTiming();
+            C c = make_filled<C>(count);
+            state.ResumeTiming();
+            auto pred = [](const auto &value) { return key_of(value) % 3 == 0; };
+            erase_if(c, pred);
+            benchmark::DoNotOptimize(c);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void sizes(benchmark::internal::Benchmark *b) {
+        b->RangeMultiplier(8)->Range(1 << 9, 1 << 18);
+    }
+
+} // namespace
+
+// Каждый сценарий прогоняется для ChunkList с разным N и для стандартных контейнеров
+#define CHUNK_LIST_BENCHMARK(bm, T)                                   \
+    BENCHMARK_TEMPLATE(bm, chunk_list_16<T>)->Apply(sizes);           \
+    BENCHMARK_TEMPLATE(bm, chunk_list_64<T>)->Apply(sizes);           \
+    BENCHMARK_TEMPLATE(bm, chunk_list_256<T>)->Apply(sizes);          \
+    BENCHMARK_TEMPLATE(bm, chunk_list_auto<T>)->Apply(sizes);         \
+    BENCHMARK_TEMPLATE(bm, std::deque<T>)->Apply(sizes);              \
+    BENCHMARK_TEMPLATE(bm, std::list<T>)->Apply(sizes)
+
+#define CHUNK_LIST_BENCHMARK_WITH_VECTOR(bm, T)                       \
+    CHUNK_LIST_BENCHMARK(bm, T);                                      \
+    BENCHMARK_TEMPLATE(bm, std::vector<T>)->Apply(sizes)
+
+CHUNK_LIST_BENCHMARK_WITH_VECTOR(BM_push_back, int);
+CHUNK_LIST_BENCHMARK_WITH_VECTOR(BM_push_back, payload64);
+CHUNK_LIST_BENCHMARK(BM_push_front, int);
+CHUNK_LIST_BENCHMARK(BM_push_front, payload64);
+CHUNK_LIST_BENCHMARK_WITH_VECTOR(BM_mid_insert_erase, int);
+CHUNK_LIST_BENCHMARK_WITH_VECTOR(BM_mid_insert_erase, payload64);
+CHUNK_LIST_BENCHMARK_WITH_VECTOR(BM_iterate, int);
+CHUNK_LIST_BENCHMARK_WITH_VECTOR(BM_iterate, payload64);
+CHUNK_LIST_BENCHMARK_WITH_VECTOR(BM_count, int);
+CHUNK_LIST_BENCHMARK_WITH_VECTOR(BM_erase_if, int);
+CHUNK_LIST_BENCHMARK_WITH_VECTOR(BM_erase_if, payload64);
+
+// У std::list нет operator[]
+BENCHMARK_TEMPLATE(BM_random_index, chunk_list_16<int>)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_random_index, chunk_list_64<int>)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_random_index, chunk_list_256<int>)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_random_index, chunk_list_auto<int>)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_random_index, std::deque<int>)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_random_index, std::vector<int>)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_random_index, chunk_list_64<payload64>)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_random_index, std::deque<payload64>)->Apply(sizes);
+
+BENCHMARK_MAIN();
@@ -18,12 +18,12 @@ int main() {
           l.push_back(dist6(rng));
         };
         ChunkList<int, 5, Allocator<int>> letters(l.begin(), l.end());
-        sestra.push_back(letters);
+        sestra.push_back(std::move(letters));
     };
 
     ChunkList_iterator<int> it{};
     for(auto element: sestra){
-        for (it = element.begin(); it < element.end(); it++){
+        for (it = element.begin(); it != element.end(); it++){
             std::cout << *it << std::endl;
         };
     };
@@ -0,0 +1,402 @@
+#include "ChunkList.hpp"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace fefu_laboratory_two;
+
+namespace {
+
+    int failures = 0;
+
+    // Печатает имя проверки, если её условие не выполнено
+    void check(const char *name, bool ok) {
+        if (!ok) {
+            std::cerr << "FAILED: " << name << '\n';
+            ++failures;
+        }
+    }
+
+    // Сравнивает содержимое списка с ожидаемым и печатает расхождение
+    template<class List>
+    void expect(const char *name, const List &list, const std::vector<std::string> &expected) {
+        bool same = list.size() == expected.size();
+        for (std::size_t i = 0; same && i < expected.size(); ++i) {
+            same = list[i] == expected[i];
+        }
+        check(name, same);
+    }
+
+    struct gap_options : chunk_list_options {
+        static constexpr bool gap_chunks = true;
+    };
+
+    struct stats_options : chunk_list_options {
+        using stats = chunk_list_stats;
+    };
+
+    // Значение, ссылающееся на элемент чанка, который сдвигается перед дописыванием
+    void push_back_aliasing_packed_chunk() {
+        ChunkList<std::string, 4> list;
+        for (const char *s: {"aaaaaaaaaaaaaaaaaaaaaaaaa", "bbbbbbbbbbbbbbbbbbbbbbbbb",
+                             "ccccccccccccccccccccccccc", "ddddddddddddddddddddddddd"}) {
+            list.push_back(s);
+        }
+        list.pop_front();
+        list.pop_front();
+        list.push_back(list.back());
+        expect("push_back(back()) into packed chunk", list,
+               {"ccccccccccccccccccccccccc", "ddddddddddddddddddddddddd", "ddddddddddddddddddddddddd"});
+
+        ChunkList<std::string, 4> grown;
+        for (const char *s: {"aaaaaaaaaaaaaaaaaaaaaaaaa", "bbbbbbbbbbbbbbbbbbbbbbbbb",
+                             "ccccccccccccccccccccccccc", "ddddddddddddddddddddddddd"}) {
+            grown.push_back(s);
+        }
+        grown.pop_front();
+        grown.pop_front();
+        grown.resize(5, grown.back());
+        expect("resize(n, back()) into packed chunk", grown,
+               {"ccccccccccccccccccccccccc", "ddddddddddddddddddddddddd", "ddddddddddddddddddddddddd",
+                "ddddddddddddddddddddddddd", "ddddddddddddddddddddddddd"});
+    }
+
+    // Вставка на стыке чанков с зазором: значение - элемент предыдущего чанка
+    void insert_aliasing_gap_chunk() {
+        ChunkList<std::string, 4, Allocator<std::string>, gap_options> list;
+        std::vector<std::string> expected;
+        for (int i = 0; i < 8; ++i) {
+            list.push_back(std::string(20, static_cast<char>('a' + i)));
+            expected.push_back(std::string(20, static_cast<char>('a' + i)));
+        }
+        list.erase(list.begin());
+        list.erase(list.begin());
+        expected.erase(expected.begin(), expected.begin() + 2);
+        list.insert(list.begin() + 2, list[1]);
+        expected.insert(expected.begin() + 2, expected[1]);
+        expect("insert(pos, l[q]) at chunk boundary", list, expected);
+    }
+
+    // Вставка нескольких копий элемента из хвоста делимого чанка
+    void insert_count_aliasing_split() {
+        ChunkList<std::string, 4> list{"aaaaaaaaaaaaaaaaaaaa", "bbbbbbbbbbbbbbbbbbbb",
+                                       "cccccccccccccccccccc", "dddddddddddddddddddd"};
+        list.insert(list.cbegin() + 1, 2, list[2]);
+        expect("insert(pos, count, l[q]) with split", list,
+               {"aaaaaaaaaaaaaaaaaaaa", "cccccccccccccccccccc", "cccccccccccccccccccc",
+                "bbbbbbbbbbbbbbbbbbbb", "cccccccccccccccccccc", "dddddddddddddddddddd"});
+    }
+
+    // Индекс позиций после вставок и удалений в середине цепочки и переноса чанков
+    void index_after_middle_changes() {
+        ChunkList<std::string, 4> list;
+        std::vector<std::string> expected;
+        for (int i = 0; i < 400; ++i) {
+            list.push_back(std::to_string(i));
+            expected.push_back(std::to_string(i));
+        }
+        for (int i = 0; i < 200; ++i) {
+            std::size_t pos = (i * 37) % expected.size();
+            list.insert(list.cbegin() + static_cast<std::ptrdiff_t>(pos), std::to_string(-i));
+            expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(pos), std::to_string(-i));
+            std::size_t gone = (i * 53) % expected.size();
+            list.erase(list.cbegin() + static_cast<std::ptrdiff_t>(gone));
+            expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(gone));
+        }
+        expect("operator[] after middle insert/erase", list, expected);
+
+        ChunkList<std::string, 4> other;
+        std::vector<std::string> moved;
+        for (int i = 0; i < 100; ++i) {
+            other.push_back("s" + std::to_string(i));
+            moved.push_back("s" + std::to_string(i));
+        }
+        list.splice(list.cbegin() + 150, other, other.cbegin() + 10, other.cbegin() + 90);
+        expected.insert(expected.begin() + 150, moved.begin() + 10, moved.begin() + 90);
+        moved.erase(moved.begin() + 10, moved.begin() + 90);
+        expect("operator[] after splice into middle", list, expected);
+        expect("operator[] after splice out of middle", other, moved);
+    }
+
+    // Курсор, заведённый до вставки и удаления перед его пальцем
+    void cursor_after_edits() {
+        ChunkList<int, 8> list;
+        for (int i = 0; i < 100; ++i) {
+            list.push_back(i);
+        }
+        ChunkList<int, 8>::cursor c(list);
+        check("cursor before edits", c[20] == 20 && c[21] == 21);
+        list.insert(list.cbegin() + 2, -1);
+        check("cursor after insert ahead", c[21] == 20 && c[21] == list[21]);
+        list.erase(list.cbegin());
+        check("cursor after erase ahead", c[21] == 21 && c[30] == list[30]);
+        // Чанк пальца освобождается целиком
+        check("cursor before erase of its chunk", c[50] == 50);
+        list.erase(list.cbegin() + 40, list.cbegin() + 70);
+        check("cursor after erase of its chunk", c[50] == 80 && c[40] == 70 && c.at(39) == 39);
+    }
+
+    // Перестановка диапазона и элемента внутри одного контейнера
+    void splice_within_list() {
+        ChunkList<std::string, 4> list;
+        std::vector<std::string> expected;
+        for (int i = 0; i < 40; ++i) {
+            list.push_back(std::to_string(i));
+            expected.push_back(std::to_string(i));
+        }
+        list.splice(list.cbegin(), list, list.cbegin() + 25, list.cend());
+        std::rotate(expected.begin(), expected.begin() + 25, expected.end());
+        expect("splice(begin, *this, range) to front", list, expected);
+
+        list.splice(list.cend(), list, list.cbegin() + 3, list.cbegin() + 13);
+        std::rotate(expected.begin() + 3, expected.begin() + 13, expected.end());
+        expect("splice(end, *this, range) to back", list, expected);
+
+        list.splice(list.cbegin() + 30, list, list.cbegin() + 6);
+        std::rotate(expected.begin() + 6, expected.begin() + 7, expected.begin() + 30);
+        expect("splice(pos, *this, it)", list, expected);
+
+        bool thrown = false;
+        try {
+            list.splice(list.cbegin() + 10, list, list.cbegin() + 5, list.cbegin() + 15);
+        } catch (const std::invalid_argument &) {
+            thrown = true;
+        }
+        check("splice(pos, *this, range) with pos inside range throws", thrown);
+        expect("list unchanged after rejected splice", list, expected);
+    }
+
+    // Счётчики статистики: выделения чанков, сдвиги элементов и переходы между чанками
+    void stats_counters() {
+        ChunkList<int, 4, Allocator<int>, stats_options> list;
+        for (int i = 0; i < 10; ++i) {
+            list.push_back(i);
+        }
+        const chunk_list_stats &stats = list.stats();
+        check("stats: chunks allocated by push_back", stats.chunk_allocations == 3);
+        check("stats: push_back shifts nothing", stats.element_shifts == 0);
+
+        // Вставка в середину неполного чанка сдвигает только хвост за позицией
+        list.reset_stats();
+        list.insert(list.cbegin() + 9, -1);
+        check("stats: insert shifts the tail once", stats.element_shifts == 1);
+
+        // Полный проход по трём чанкам - два перехода, каким бы способом он ни делался
+        list.reset_stats();
+        long sum = 0;
+        for (int value: list) {
+            sum += value;
+        }
+        check("stats: iteration counts hops", stats.chunk_hops == 2);
+        list.reset_stats();
+        for (auto part: list.chunks()) {
+            sum += static_cast<long>(part.size());
+        }
+        check("stats: chunks() counts hops", stats.chunk_hops == 2);
+        list.reset_stats();
+        check("stats: find walks all chunks", find(list.begin(), list.end(), 100) == list.end());
+        check("stats: segmented find counts hops", stats.chunk_hops == 2);
+        list.reset_stats();
+        check("stats: iterator advance", *(list.begin() + 10) == 9);
+        check("stats: iterator advance counts hops", stats.chunk_hops == 2);
+
+        // Перенесённые чанки считают переходы в новом владельце
+        auto moved = std::move(list);
+        moved.reset_stats();
+        for (int value: moved) {
+            sum += value;
+        }
+        check("stats: moved chain counts hops in new owner", moved.stats().chunk_hops == 2 && sum != 0);
+    }
+
+    // compact(budget) учитывает и сдвиг элементов чанка-приёмника к началу массива
+    void compact_budget_includes_packing() {
+        ChunkList<int, 8, Allocator<int>, stats_options> list;
+        for (int i = 0; i < 24; ++i) {
+            list.push_back(i);
+        }
+        // Первый чанк: два элемента в конце массива, второй - два в начале
+        for (int i = 0; i < 6; ++i) {
+            list.pop_front();
+        }
+        list.erase(list.cbegin() + 4, list.cbegin() + 10);
+        list.reset_stats();
+        check("compact: merge over budget is skipped", list.compact(3) == 0);
+        check("compact: skipped merge moves nothing", list.stats().element_shifts == 0);
+        check("compact: merge within budget", list.compact(4) == 1);
+        check("compact: shifts stay within budget", list.stats().element_shifts <= 4);
+        std::vector<int> expected{6, 7, 8, 9};
+        for (int i = 16; i < 24; ++i) {
+            expected.push_back(i);
+        }
+        bool same = list.size() == expected.size();
+        for (std::size_t i = 0; same && i < expected.size(); ++i) {
+            same = list[i] == expected[i];
+        }
+        check("compact: contents kept", same);
+    }
+
+    // min_element и max_element для float и double с NaN в начале, середине и конце, в том
+    // числе в начале чанка
+    template<typename Real>
+    void extremum_with_nan() {
+        const Real nan = std::numeric_limits<Real>::quiet_NaN();
+        for (std::size_t at: {std::size_t{0}, std::size_t{8}, std::size_t{17}, std::size_t{32}, std::size_t{39}}) {
+            std::vector<Real> values;
+            for (int i = 0; i < 40; ++i) {
+                values.push_back(static_cast<Real>((i * 7) % 23) - Real(11));
+            }
+            values[at] = nan;
+            ChunkList<Real, 8> list(values.begin(), values.end());
+            auto min = fefu_laboratory_two::min_element(list.cbegin(), list.cend());
+            auto max = fefu_laboratory_two::max_element(list.cbegin(), list.cend());
+            auto expected_min = std::min_element(values.begin(), values.end()) - values.begin();
+            auto expected_max = std::max_element(values.begin(), values.end()) - values.begin();
+            check("min_element with NaN matches std", min - list.cbegin() == expected_min);
+            check("max_element with NaN matches std", max - list.cbegin() == expected_max);
+            check("count(NaN) is zero", fefu_laboratory_two::count(list.cbegin(), list.cend(), nan) == 0);
+            check("find(NaN) finds nothing", fefu_laboratory_two::find(list.cbegin(), list.cend(), nan) == list.cend());
+        }
+    }
+
+    // accumulate с std::plus<> и plus<T> при начальном значении шире элементов
+    void accumulate_wider_init() {
+        std::vector<int> values;
+        for (int i = 0; i < 100; ++i) {
+            values.push_back(std::numeric_limits<int>::max() / 64 + i);
+        }
+        ChunkList<int, 16> list(values.begin(), values.end());
+        check("accumulate(long long, plus<>) matches std",
+              fefu_laboratory_two::accumulate(list.cbegin(), list.cend(), 0LL, std::plus<>()) ==
+              std::accumulate(values.begin(), values.end(), 0LL, std::plus<>()));
+        check("accumulate(long long) matches std",
+              fefu_laboratory_two::accumulate(list.cbegin(), list.cend(), 0LL) ==
+              std::accumulate(values.begin(), values.end(), 0LL));
+
+        // plus<int> приводит начальное значение к int: 2^33 превращается в 0
+        std::vector<int> small(values.size(), 3);
+        ChunkList<int, 16> small_list(small.begin(), small.end());
+        const long long wide = 1LL << 33;
+        check("accumulate(long long, plus<int>) matches std",
+              fefu_laboratory_two::accumulate(small_list.cbegin(), small_list.cend(), wide, std::plus<int>()) ==
+              std::accumulate(small.begin(), small.end(), wide, std::plus<int>()));
+        check("accumulate(int, plus<int>) matches std",
+              fefu_laboratory_two::accumulate(small_list.cbegin(), small_list.cend(), 5, std::plus<int>()) ==
+              std::accumulate(small.begin(), small.end(), 5, std::plus<int>()));
+
+        std::vector<float> reals;
+        for (int i = 0; i < 100; ++i) {
+            reals.push_back(1.0f / static_cast<float>(i + 1));
+        }
+        ChunkList<float, 16> real_list(reals.begin(), reals.end());
+        check("accumulate(double, plus<>) over float matches std",
+              fefu_laboratory_two::accumulate(real_list.cbegin(), real_list.cend(), 0.0, std::plus<>()) ==
+              std::accumulate(reals.begin(), reals.end(), 0.0, std::plus<>()));
+        check("accumulate(double, plus<float>) over float matches std",
+              fefu_laboratory_two::accumulate(real_list.cbegin(), real_list.cend(), 0.0, std::plus<float>()) ==
+              std::accumulate(reals.begin(), reals.end(), 0.0, std::plus<float>()));
+    }
+
+    // Сравнивает элементы списка с ожидаемыми на выборке позиций, обращаясь через индекс позиций
+    template<class List>
+    void expect_sampled(const char *name, const List &list, const std::vector<int> &expected) {
+        bool same = list.size() == expected.size();
+        for (std::size_t i = 0; same && i < expected.size(); i += 7) {
+            same = list[i] == expected[i] && list.at(i) == expected[i];
+        }
+        if (same && !expected.empty()) {
+            same = list[expected.size() - 1] == expected.back();
+        }
+        check(name, same);
+    }
+
+    // Многоуровневый индекс позиций: больше 16^2 чанков, удаление чанков через один,
+    // перенос и отделение частей, массовое удаление
+    void index_multilevel() {
+        ChunkList<int, 4> list;
+        std::vector<int> expected;
+        for (int i = 0; i < 1200; ++i) {
+            list.push_back(i);
+            expected.push_back(i);
+        }
+        for (int i = 0; i < 300; ++i) {
+            std::size_t pos = (static_cast<std::size_t>(i) * 131) % expected.size();
+            list.insert(list.cbegin() + static_cast<std::ptrdiff_t>(pos), -i);
+            expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(pos), -i);
+        }
+        expect_sampled("multilevel index after growth", list, expected);
+
+        // Каждый второй чанк удаляется целиком, с конца, чтобы начала остальных не сдвигались
+        std::vector<std::size_t> starts;
+        std::vector<std::size_t> sizes;
+        std::size_t start = 0;
+        for (auto part: list.chunks()) {
+            starts.push_back(start);
+            sizes.push_back(part.size());
+            start += part.size();
+        }
+        for (std::size_t c = starts.size(); c-- > 0;) {
+            if (c % 2 == 1) {
+                auto first = static_cast<std::ptrdiff_t>(starts[c]);
+                auto last = first + static_cast<std::ptrdiff_t>(sizes[c]);
+                list.erase(list.cbegin() + first, list.cbegin() + last);
+                expected.erase(expected.begin() + first, expected.begin() + last);
+            }
+        }
+        expect_sampled("multilevel index after erasing every other chunk", list, expected);
+
+        ChunkList<int, 4> other;
+        other.splice(other.cend(), list, list.cbegin() + 100, list.cbegin() + 500);
+        std::vector<int> other_expected(expected.begin() + 100, expected.begin() + 500);
+        expected.erase(expected.begin() + 100, expected.begin() + 500);
+        expect_sampled("multilevel index after splice out", list, expected);
+        expect_sampled("multilevel index of splice target", other, other_expected);
+
+        list.splice(list.cbegin() + 50, other, other.cbegin() + 10, other.cbegin() + 300);
+        expected.insert(expected.begin() + 50, other_expected.begin() + 10, other_expected.begin() + 300);
+        other_expected.erase(other_expected.begin() + 10, other_expected.begin() + 300);
+        expect_sampled("multilevel index after splice back", list, expected);
+        expect_sampled("multilevel index of splice source", other, other_expected);
+
+        ChunkList<int, 4> tail = list.split_at(list.cbegin() + 333);
+        std::vector<int> tail_expected(expected.begin() + 333, expected.end());
+        expected.resize(333);
+        expect_sampled("multilevel index after split_at", list, expected);
+        expect_sampled("multilevel index of split tail", tail, tail_expected);
+
+        // Массовое удаление и повторный рост
+        while (tail.size() > 40) {
+            std::size_t pos = (tail.size() * 5) / 11;
+            tail.erase(tail.cbegin() + static_cast<std::ptrdiff_t>(pos));
+            tail_expected.erase(tail_expected.begin() + static_cast<std::ptrdiff_t>(pos));
+        }
+        expect_sampled("multilevel index after mass erase", tail, tail_expected);
+        for (int i = 0; i < 400; ++i) {
+            std::size_t pos = (static_cast<std::size_t>(i) * 17) % (tail_expected.size() + 1);
+            tail.insert(tail.cbegin() + static_cast<std::ptrdiff_t>(pos), 10000 + i);
+            tail_expected.insert(tail_expected.begin() + static_cast<std::ptrdiff_t>(pos), 10000 + i);
+        }
+        expect_sampled("multilevel index after regrowth", tail, tail_expected);
+    }
+
+}
+
+int main() {
+    push_back_aliasing_packed_chunk();
+    insert_aliasing_gap_chunk();
+    insert_count_aliasing_split();
+    index_after_middle_changes();
+    cursor_after_edits();
+    splice_within_list();
+    stats_counters();
+    compact_budget_includes_packing();
+    extremum_with_nan<float>();
+    extremum_with_nan<double>();
+    accumulate_wider_init();
+    index_multilevel();
+    return failures == 0 ? 0 : 1;
+}